@@ -129,7 +129,7 @@ function Set-Vars {
     $script:CXXFLAGS += " "
     $script:CXXFLAGS += $DEBUGFLAGS
     $script:CXXFLAGS += " "
-    $script:CXXFLAGS += "-std=$STANDARD"
+    $script:CXXFLAGS += "-std=$STANDARD -pthread"
 }
 
 NoMake
@@ -0,0 +1,583 @@
+/**
+ * @file bitset.hpp
+ * @brief Bit-packed vertex sets and the SIMD kernels that crunch them
+ */
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Everything to do with bit-packed vertex sets
+ *
+ * A "set" here is just a span of words, where bit (v % 64) of word (v / 64)
+ * says whether vertex v is in there.\n
+ * The hot operations (AND, AND-NOT, popcount) go through a Kernels table
+ * that gets picked once, based on what the CPU supports.\n
+ * Small graphs can use FixedSet instead, where the word count is known at
+ * compile time and the same operations are plain unrolled loops
+ */
+namespace bits {
+
+/**
+ * @brief The word that sets are packed into
+ */
+using Word = std::uint64_t;
+
+/**
+ * @brief Number of bits in a Word
+ */
+constexpr size_t WORD_BITS = std::numeric_limits<Word>::digits;
+
+/**
+ * @brief Number of words needed to hold some number of bits
+ *
+ * @param bitCount the number of bits
+ *
+ * @return ceil(bitCount / WORD_BITS)
+ */
+[[nodiscard]] constexpr auto wordsFor(size_t bitCount) -> size_t {
+    return (bitCount + WORD_BITS - 1) / WORD_BITS;
+}
+
+/**
+ * @brief Which instruction set a kernel table was built for
+ */
+enum class KernelLevel { SCALAR, AVX2, AVX512 };
+
+/**
+ * @brief Table of set kernels for one instruction set
+ *
+ * All spans passed to one call must have the same length,
+ * and out is allowed to alias either input
+ */
+struct Kernels {
+    /**
+     * @brief The instruction set used by this table
+     */
+    KernelLevel level;
+
+    /**
+     * @brief out = lhs & rhs
+     */
+    auto (*intersect)(std::span<const Word> lhs, std::span<const Word> rhs,
+                      std::span<Word> out) -> void;
+
+    /**
+     * @brief popcount(lhs & rhs), without writing the intersection anywhere
+     */
+    auto (*intersectCount)(std::span<const Word> lhs,
+                           std::span<const Word> rhs) -> size_t;
+
+    /**
+     * @brief out = lhs & ~rhs
+     */
+    auto (*andNot)(std::span<const Word> lhs, std::span<const Word> rhs,
+                   std::span<Word> out) -> void;
+
+    /**
+     * @brief popcount(set)
+     */
+    auto (*count)(std::span<const Word> set) -> size_t;
+};
+
+/**
+ * @brief The kernels used by everything else
+ *
+ * Picked via CPUID the first time they're needed, and never changed again
+ *
+ * @return The best kernel table this CPU can run
+ */
+[[nodiscard]] auto kernels() -> const Kernels&;
+
+/**
+ * @brief Every kernel table this CPU can run, scalar first
+ *
+ * Mostly useful for checking that the SIMD kernels agree with the scalar
+ * ones
+ *
+ * @return the tables, from least to most fancy
+ */
+[[nodiscard]] auto availableKernels() -> std::vector<Kernels>;
+
+/**
+ * @brief Human readable name of a kernel level, for logs and such
+ *
+ * @param level the level
+ *
+ * @return "scalar", "avx2" or "avx512"
+ */
+[[nodiscard]] auto kernelLevelName(KernelLevel level) -> const char*;
+
+/**
+ * @brief out = lhs & rhs, using the dispatched kernel
+ *
+ * @param lhs first operand
+ * @param rhs second operand
+ * @param out where to write the result, may alias either operand
+ */
+inline auto intersect(std::span<const Word> lhs, std::span<const Word> rhs,
+                      std::span<Word> out) -> void {
+    kernels().intersect(lhs, rhs, out);
+}
+
+/**
+ * @brief popcount(lhs & rhs), using the dispatched kernel
+ *
+ * @param lhs first operand
+ * @param rhs second operand
+ *
+ * @return number of bits set in both
+ */
+[[nodiscard]] inline auto intersectCount(std::span<const Word> lhs,
+                                         std::span<const Word> rhs) -> size_t {
+    return kernels().intersectCount(lhs, rhs);
+}
+
+/**
+ * @brief out = lhs & ~rhs, using the dispatched kernel
+ *
+ * @param lhs first operand
+ * @param rhs the bits to remove from lhs
+ * @param out where to write the result, may alias either operand
+ */
+inline auto andNot(std::span<const Word> lhs, std::span<const Word> rhs,
+                   std::span<Word> out) -> void {
+    kernels().andNot(lhs, rhs, out);
+}
+
+/**
+ * @brief popcount(set), using the dispatched kernel
+ *
+ * @param set the set to count
+ *
+ * @return number of bits set
+ */
+[[nodiscard]] inline auto count(std::span<const Word> set) -> size_t {
+    return kernels().count(set);
+}
+
+/**
+ * @brief A set whose size is known at compile time
+ *
+ * @tparam Words number of words, so it holds Words * WORD_BITS bits
+ */
+template <size_t Words>
+using FixedSet = std::array<Word, Words>;
+
+/**
+ * @brief out = lhs & rhs, unrolled for FixedSet
+ *
+ * @tparam Words the set size
+ * @param lhs first operand
+ * @param rhs second operand
+ * @param out where to write the result, may alias either operand
+ */
+template <size_t Words>
+constexpr auto intersect(const FixedSet<Words>& lhs, const FixedSet<Words>& rhs,
+                         FixedSet<Words>& out) -> void {
+    for (size_t i = 0; i < Words; ++i) {
+        out[i] = lhs[i] & rhs[i];
+    }
+}
+
+/**
+ * @brief popcount(lhs & rhs), unrolled for FixedSet
+ *
+ * @tparam Words the set size
+ * @param lhs first operand
+ * @param rhs second operand
+ *
+ * @return number of bits set in both
+ */
+template <size_t Words>
+[[nodiscard]] constexpr auto intersectCount(const FixedSet<Words>& lhs,
+                                            const FixedSet<Words>& rhs)
+    -> size_t {
+    size_t total = 0;
+    for (size_t i = 0; i < Words; ++i) {
+        total += static_cast<size_t>(std::popcount(lhs[i] & rhs[i]));
+    }
+
+    return total;
+}
+
+/**
+ * @brief out = lhs & ~rhs, unrolled for FixedSet
+ *
+ * @tparam Words the set size
+ * @param lhs first operand
+ * @param rhs the bits to remove from lhs
+ * @param out where to write the result, may alias either operand
+ */
+template <size_t Words>
+constexpr auto andNot(const FixedSet<Words>& lhs, const FixedSet<Words>& rhs,
+                      FixedSet<Words>& out) -> void {
+    for (size_t i = 0; i < Words; ++i) {
+        out[i] = lhs[i] & ~rhs[i];
+    }
+}
+
+/**
+ * @brief popcount(set), unrolled for FixedSet
+ *
+ * @tparam Words the set size
+ * @param set the set to count
+ *
+ * @return number of bits set
+ */
+template <size_t Words>
+[[nodiscard]] constexpr auto count(const FixedSet<Words>& set) -> size_t {
+    size_t total = 0;
+    for (Word word : set) {
+        total += static_cast<size_t>(std::popcount(word));
+    }
+
+    return total;
+}
+
+/**
+ * @brief Checks whether a bit is set
+ *
+ * @param set the set to look in
+ * @param bit the bit to check
+ *
+ * @return `true` iff bit is in set
+ */
+[[nodiscard]] inline auto test(std::span<const Word> set, size_t bit) -> bool {
+    return ((set[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1U) != 0;
+}
+
+/**
+ * @brief Adds a bit to a set
+ *
+ * @param set the set to modify
+ * @param bit the bit to add
+ */
+inline auto set(std::span<Word> set, size_t bit) -> void {
+    set[bit / WORD_BITS] |= Word{1} << (bit % WORD_BITS);
+}
+
+/**
+ * @brief Removes a bit from a set
+ *
+ * @param set the set to modify
+ * @param bit the bit to remove
+ */
+inline auto reset(std::span<Word> set, size_t bit) -> void {
+    set[bit / WORD_BITS] &= ~(Word{1} << (bit % WORD_BITS));
+}
+
+/**
+ * @brief Finds the lowest set bit at or after some position
+ *
+ * @param set the set to look in
+ * @param from the first bit that's allowed to be returned
+ *
+ * @return the bit, or set.size() * WORD_BITS if there's none
+ */
+[[nodiscard]] inline auto nextSet(std::span<const Word> set, size_t from)
+    -> size_t {
+    size_t wordIndex = from / WORD_BITS;
+    if (wordIndex >= set.size()) {
+        return set.size() * WORD_BITS;
+    }
+
+    Word word = set[wordIndex] & (~Word{0} << (from % WORD_BITS));
+    while (word == 0) {
+        if (++wordIndex == set.size()) {
+            return set.size() * WORD_BITS;
+        }
+        word = set[wordIndex];
+    }
+
+    return wordIndex * WORD_BITS + static_cast<size_t>(std::countr_zero(word));
+}
+
+/**
+ * @brief Checks whether a set has no bits at all
+ *
+ * @param set the set to check
+ *
+ * @return `true` iff nothing is set
+ */
+[[nodiscard]] inline auto none(std::span<const Word> set) -> bool {
+    for (Word word : set) {
+        if (word != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief A matrix of bits, stored as rows of packed words
+ *
+ * Usually square (adjacency), but doesn't have to be.\n
+ * Rows are padded to a whole number of words, and the padding is always 0
+ */
+class BitMatrix {
+   private:
+    /**
+     * @brief Number of rows
+     */
+    size_t size;
+
+    /**
+     * @brief Number of words per row
+     */
+    size_t stride;
+
+    /**
+     * @brief All the rows, one after the other
+     */
+    std::vector<Word> words;
+
+   public:
+    /**
+     * @brief Makes an empty 0x0 matrix
+     */
+    BitMatrix() : size{0}, stride{0} {}
+
+    /**
+     * @brief Makes an all-zero size*size matrix
+     *
+     * @param size the number of rows and columns
+     */
+    explicit BitMatrix(size_t size) : BitMatrix{size, size} {}
+
+    /**
+     * @brief Makes an all-zero rowCount*columnCount matrix
+     *
+     * @param rowCount the number of rows
+     * @param columnCount the number of columns (bits per row)
+     */
+    BitMatrix(size_t rowCount, size_t columnCount)
+        : size{rowCount},
+          stride{wordsFor(columnCount)},
+          words(rowCount * stride) {}
+
+    /**
+     * @brief Number of rows
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto getSize() const -> size_t { return size; }
+
+    /**
+     * @brief Number of words in each row
+     *
+     * @return the stride
+     */
+    [[nodiscard]] auto getStride() const -> size_t { return stride; }
+
+    /**
+     * @brief A row, as a set
+     *
+     * @param row which row
+     *
+     * @return span over that row's words
+     */
+    [[nodiscard]] auto operator[](size_t row) -> std::span<Word> {
+        return std::span<Word>{words}.subspan(row * stride, stride);
+    }
+
+    /**
+     * @brief A row, as a set
+     *
+     * @param row which row
+     *
+     * @return span over that row's words
+     */
+    [[nodiscard]] auto operator[](size_t row) const -> std::span<const Word> {
+        return std::span<const Word>{words}.subspan(row * stride, stride);
+    }
+
+    /**
+     * @brief Checks a single bit
+     *
+     * @param row the row
+     * @param col the column
+     *
+     * @return `true` iff (row, col) is set
+     */
+    [[nodiscard]] auto test(size_t row, size_t col) const -> bool {
+        return bits::test((*this)[row], col);
+    }
+
+    /**
+     * @brief Sets a single bit
+     *
+     * @param row the row
+     * @param col the column
+     */
+    auto set(size_t row, size_t col) -> void { bits::set((*this)[row], col); }
+};
+
+/**
+ * @brief Compile time sized counterpart of BitMatrix
+ *
+ * Lives wherever it's declared (usually the stack), so no heap involved.\n
+ * Only the first getSize() rows are meant to be used, but all of them
+ * exist and start off as 0
+ *
+ * @tparam Words words per row
+ * @tparam Rows capacity, in rows
+ */
+template <size_t Words, size_t Rows>
+class FixedBitMatrix {
+   private:
+    /**
+     * @brief Number of rows in use
+     */
+    size_t size;
+
+    /**
+     * @brief All the rows
+     */
+    std::array<FixedSet<Words>, Rows> rows{};
+
+   public:
+    /**
+     * @brief Makes an all-zero matrix
+     *
+     * Same shape as the BitMatrix constructor, so generic code can make
+     * either one the same way
+     *
+     * @param rowCount the number of rows in use, at most Rows
+     * @param columnCount ignored, at most Words * WORD_BITS
+     */
+    FixedBitMatrix(size_t rowCount, [[maybe_unused]] size_t columnCount)
+        : size{rowCount} {}
+
+    /**
+     * @brief Number of rows in use
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto getSize() const -> size_t { return size; }
+
+    /**
+     * @brief Number of words in each row
+     *
+     * @return Words
+     */
+    [[nodiscard]] static constexpr auto getStride() -> size_t { return Words; }
+
+    /**
+     * @brief A row, as a set
+     *
+     * @param row which row
+     *
+     * @return the row
+     */
+    [[nodiscard]] auto operator[](size_t row) -> FixedSet<Words>& {
+        return rows[row];
+    }
+
+    /**
+     * @brief A row, as a set
+     *
+     * @param row which row
+     *
+     * @return the row
+     */
+    [[nodiscard]] auto operator[](size_t row) const -> const FixedSet<Words>& {
+        return rows[row];
+    }
+
+    /**
+     * @brief Checks a single bit
+     *
+     * @param row the row
+     * @param col the column
+     *
+     * @return `true` iff (row, col) is set
+     */
+    [[nodiscard]] auto test(size_t row, size_t col) const -> bool {
+        return bits::test(rows[row], col);
+    }
+
+    /**
+     * @brief Sets a single bit
+     *
+     * @param row the row
+     * @param col the column
+     */
+    auto set(size_t row, size_t col) -> void { bits::set(rows[row], col); }
+};
+
+/**
+ * @brief FixedBitMatrix when Words != 0, BitMatrix otherwise
+ *
+ * Both get constructed as `BitRows<...>{rowCount, columnCount}`
+ *
+ * @tparam Words words per row, or 0 for "decide at runtime"
+ * @tparam Rows row capacity of the fixed version
+ */
+template <size_t Words, size_t Rows>
+using BitRows =
+    std::conditional_t<Words == 0, BitMatrix, FixedBitMatrix<Words, Rows>>;
+
+/**
+ * @brief Copies a BitMatrix into BitRows
+ *
+ * @tparam Words words per row of the result, or 0 for another BitMatrix
+ * @tparam Rows row capacity of the result
+ * @param matrix the matrix to copy, must fit in the result
+ *
+ * @return the copy
+ */
+template <size_t Words, size_t Rows>
+[[nodiscard]] auto copyRows(const BitMatrix& matrix) -> BitRows<Words, Rows> {
+    if constexpr (Words == 0) {
+        return matrix;
+    } else {
+        BitRows<Words, Rows> copy{matrix.getSize(), 0};
+        for (size_t row = 0; row < matrix.getSize(); ++row) {
+            for (size_t word = 0; word < matrix.getStride(); ++word) {
+                copy[row][word] = matrix[row][word];
+            }
+        }
+        return copy;
+    }
+}
+
+/**
+ * @brief Largest set size (in bits) that still gets a FixedSet
+ */
+constexpr size_t MAX_FIXED_BITS = 4 * WORD_BITS;
+
+/**
+ * @brief Picks a compile time word count for sets of some size
+ *
+ * Calls body with a std::integral_constant of 1, 2 or 4 for sets of up to
+ * 64, 128 or 256 bits, and 0 (meaning: use BitMatrix and the dispatched
+ * kernels) for anything bigger
+ *
+ * @param bitCount number of bits the sets need to hold
+ * @param body generic callable, taking the integral_constant
+ *
+ * @return whatever body returns
+ */
+template <typename Body>
+auto withFixedWords(size_t bitCount, Body&& body) {
+    if (bitCount <= WORD_BITS) {
+        return body(std::integral_constant<size_t, 1>{});
+    }
+    if (bitCount <= 2 * WORD_BITS) {
+        return body(std::integral_constant<size_t, 2>{});
+    }
+    if (bitCount <= MAX_FIXED_BITS) {
+        return body(std::integral_constant<size_t, MAX_FIXED_BITS / WORD_BITS>{});
+    }
+    return body(std::integral_constant<size_t, 0>{});
+}
+
+}  // namespace bits
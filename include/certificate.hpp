@@ -0,0 +1,131 @@
+/**
+ * @file certificate.hpp
+ * @brief Proofs that a clique is maximum, and checking them
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief One node of a proof that some candidates can't hold a big clique
+ *
+ * A node stands for a node of the branch and bound: some candidates, each
+ * adjacent to the whole clique so far, and a budget, the most vertices a
+ * clique among them may have. It proves its candidates stay within the
+ * budget in one of two ways:
+ * - a coloring: the candidates split into at most budget-many independent
+ * sets, and a clique gets at most one vertex from each
+ * - branching: children for the first few candidates (in vertex order),
+ * child i for the candidates after candidate i that are adjacent to it,
+ * with one less budget. Whatever's left after them is no more than the
+ * budget on its own.
+ */
+struct ProofNode {
+    /**
+     * @brief The color classes, empty for a branching node
+     */
+    std::vector<std::vector<size_t>> coloring;
+
+    /**
+     * @brief Proofs for the first children.size() candidates
+     */
+    std::vector<ProofNode> children;
+};
+
+/**
+ * @brief A clique, and a proof that there's none bigger
+ */
+struct CliqueCertificate {
+    /**
+     * @brief Vertices of the graph it's for
+     */
+    size_t vertexCount{0};
+
+    /**
+     * @brief fingerprint() of the adjacency it's for
+     */
+    std::uint64_t fingerprint{0};
+
+    /**
+     * @brief The clique, sorted
+     */
+    std::vector<size_t> clique;
+
+    /**
+     * @brief Root over every vertex, with the clique's size as the budget
+     */
+    ProofNode proof;
+};
+
+/**
+ * @brief Proves a clique is maximum
+ *
+ * A branch and bound with the answer already known: nothing to find, only
+ * branches to close, with the same coloring bound as Graph::maxCliqueHelper.
+ * That's the part of the exact search that takes the time anyway, so this
+ * costs about as much as a search that got the answer right at the start.
+ * Every node it closes by coloring keeps its color classes, and every node
+ * it closes by counting keeps nothing.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param clique a maximum clique, in any order
+ *
+ * @throws std::invalid_argument if it's not a clique, or not a maximum one
+ *
+ * @return the certificate
+ */
+[[nodiscard]] auto certifyClique(const bits::BitMatrix& adjacency,
+                                 std::vector<size_t> clique)
+    -> CliqueCertificate;
+
+/**
+ * @brief Checks a certificate, without searching anything
+ *
+ * Polynomial in the size of the certificate: each node costs an
+ * intersection per child, and a look at every edge inside its color
+ * classes.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param certificate what to check
+ *
+ * @return `true` iff it's for this graph, the clique is a clique, and the
+ * proof holds, so no clique is bigger
+ */
+[[nodiscard]] auto verifyCertificate(const bits::BitMatrix& adjacency,
+                                     const CliqueCertificate& certificate)
+    -> bool;
+
+/**
+ * @brief Writes a certificate to a file
+ *
+ * @param certificate the certificate
+ * @param path where to write it
+ *
+ * @throws std::runtime_error if the file can't be written
+ */
+auto saveCertificate(const CliqueCertificate& certificate,
+                     const std::string& path) -> void;
+
+/**
+ * @brief Reads a certificate saveCertificate wrote
+ *
+ * Only checks that it's well formed, see verifyCertificate for whether it
+ * proves anything
+ *
+ * @param path where to read it from
+ *
+ * @throws std::invalid_argument if the file can't be opened, or isn't a
+ * certificate, or has vertices out of range
+ *
+ * @return the certificate
+ */
+[[nodiscard]] auto loadCertificate(const std::string& path)
+    -> CliqueCertificate;
+
+}  // namespace clique
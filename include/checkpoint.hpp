@@ -0,0 +1,99 @@
+/**
+ * @file checkpoint.hpp
+ * @brief Saving and loading the state of an interrupted clique search
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief A subtree of the branch and bound nobody's been through yet
+ *
+ * Same as a node of maxCliqueHelper: the clique so far, and the vertices
+ * still left to branch on
+ */
+struct FrontierTask {
+    /**
+     * @brief The clique at the root of the subtree
+     */
+    std::vector<size_t> clique;
+
+    /**
+     * @brief What can still extend it, all adjacent to the whole clique
+     */
+    std::vector<size_t> candidates;
+};
+
+/**
+ * @brief Everything a clique search needs to pick up where it left off
+ */
+struct SearchState {
+    /**
+     * @brief Which search wrote it, a resume has to be the same one
+     */
+    std::string kind;
+
+    /**
+     * @brief Vertices of the graph it ran on
+     */
+    size_t vertexCount{0};
+
+    /**
+     * @brief fingerprint() of the adjacency it ran on
+     */
+    std::uint64_t fingerprint{0};
+
+    /**
+     * @brief The best cliques so far, one unless ties were kept
+     */
+    std::vector<std::vector<size_t>> incumbents;
+
+    /**
+     * @brief What's left to search, the last task goes first
+     */
+    std::vector<FrontierTask> frontier;
+};
+
+/**
+ * @brief Hash of an adjacency, so a state doesn't get resumed on a
+ * different graph by mistake
+ *
+ * @param adjacency the adjacency bits the search runs on
+ *
+ * @return FNV-1a over the rows
+ */
+[[nodiscard]] auto fingerprint(const bits::BitMatrix& adjacency)
+    -> std::uint64_t;
+
+/**
+ * @brief Writes a state to a file
+ *
+ * It goes to a temporary file next to it first, which then replaces the old
+ * one, so getting killed halfway through leaves the last state intact.
+ *
+ * @param state the state
+ * @param path where to write it
+ *
+ * @throws std::runtime_error if the file can't be written
+ */
+auto saveState(const SearchState& state, const std::string& path) -> void;
+
+/**
+ * @brief Reads a state saveState wrote
+ *
+ * @param path where to read it from
+ *
+ * @throws std::invalid_argument if the file can't be opened, or isn't a
+ * state, or has vertices out of range
+ *
+ * @return the state
+ */
+[[nodiscard]] auto loadState(const std::string& path) -> SearchState;
+
+}  // namespace clique
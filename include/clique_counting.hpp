@@ -0,0 +1,56 @@
+/**
+ * @file clique_counting.hpp
+ * @brief Counting small cliques, for fingerprinting big sparse graphs
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace clique {
+
+/**
+ * @brief How many cliques of one size a graph has
+ */
+struct CliqueCounts {
+    /**
+     * @brief Cliques of this size
+     */
+    std::uint64_t total{0};
+
+    /**
+     * @brief For each vertex, how many of those cliques it's in. These sum
+     * up to the size times the total.
+     */
+    std::vector<std::uint64_t> perVertex;
+};
+
+/**
+ * @brief Counts the cliques of every size up to maxSize
+ *
+ * Chiba & Nishizeki / Danisch et al. style: the edges get pointed along a
+ * degeneracy order, so every clique is counted once, from its first
+ * vertex, and each vertex only ever looks at its later neighbours, of
+ * which there are at most degeneracy-many. Those get their own little
+ * bitset adjacency, and from there it's intersections all the way down,
+ * the deepest level being a single popcount.\n
+ * The outer vertices are split between threads by work stealing. Memory is
+ * the lists, the per-vertex counts, and a degeneracy-squared bitset per
+ * thread, so graphs with 10^5 vertices are fine as long as they're sparse.
+ * Counts wrap around past 2^64, which only dense graphs and big sizes get
+ * anywhere near.
+ *
+ * @param neighbours adjacency lists of a simple undirected graph, every
+ * edge in both lists, no loops or repeats
+ * @param maxSize biggest cliques to count
+ * @param threadCount threads to count on, 0 counts as 1
+ *
+ * @return maxSize + 1 entries, entry k for the cliques with k vertices.
+ * Entry 0 is the empty clique, entry 1 the vertices, entry 2 the edges.
+ */
+[[nodiscard]] auto countCliques(
+    const std::vector<std::vector<size_t>>& neighbours, size_t maxSize,
+    size_t threadCount = 1) -> std::vector<CliqueCounts>;
+
+}  // namespace clique
@@ -0,0 +1,982 @@
+/**
+ * @file clique_policies.hpp
+ * @brief Compile time knobs for the clique search
+ *
+ * Graph::maxCliqueHelper is a template over one policy from each group here,
+ * so every combination compiles to its own loop, without runtime checks or
+ * bookkeeping for the features it doesn't use
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "bitset.hpp"
+
+/**
+ * @brief Policies for Graph::maxCliqueHelper
+ */
+namespace clique {
+
+/**
+ * @brief Adjacency policy: i and j are adjacent iff i->j and j->i both exist
+ *
+ * Used by maxClique
+ */
+struct MutualAdjacency {
+    /**
+     * @brief Combines successor and predecessor bits into adjacency bits
+     *
+     * @param successors a word of successor bits
+     * @param predecessors the matching word of predecessor bits
+     *
+     * @return successors & predecessors
+     */
+    [[nodiscard]] static constexpr auto combine(bits::Word successors,
+                                                bits::Word predecessors)
+        -> bits::Word {
+        return successors & predecessors;
+    }
+};
+
+/**
+ * @brief Adjacency policy: i and j are adjacent iff i->j or j->i exists
+ *
+ * Used by modifiedMaxClique
+ */
+struct EitherAdjacency {
+    /**
+     * @brief Combines successor and predecessor bits into adjacency bits
+     *
+     * @param successors a word of successor bits
+     * @param predecessors the matching word of predecessor bits
+     *
+     * @return successors | predecessors
+     */
+    [[nodiscard]] static constexpr auto combine(bits::Word successors,
+                                                bits::Word predecessors)
+        -> bits::Word {
+        return successors | predecessors;
+    }
+};
+
+/**
+ * @brief Accuracy policy: search the whole tree
+ *
+ * Carries no state at all
+ */
+struct Exact {
+    /**
+     * @brief Every thread of a parallel search can ask the same one
+     */
+    static constexpr bool SHAREABLE = true;
+
+    /**
+     * @brief Whether the search should give up now
+     *
+     * @return `false`, always
+     */
+    [[nodiscard]] static constexpr auto exhausted() -> bool { return false; }
+};
+
+/**
+ * @brief Accuracy policy: give up after a node budget or a deadline
+ *
+ * Whichever runs out first. AlgorithmAccuracy::APPROXIMATE is just a node
+ * budget, Graph::anytimeMaxClique can use either or both
+ */
+class Budget {
+   private:
+    /**
+     * @brief How many nodes go by between looks at the clock
+     *
+     * Reading the clock costs more than expanding a small node does
+     */
+    static constexpr size_t CLOCK_INTERVAL = 64;
+
+    /**
+     * @brief Nodes expanded so far
+     */
+    size_t nodeCount{0};
+
+    /**
+     * @brief Nodes we're allowed to expand
+     */
+    size_t nodeLimit;
+
+    /**
+     * @brief When to stop, if ever
+     */
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+
+    /**
+     * @brief Whether the budget already ran out, so it stays run out
+     */
+    bool stopped{false};
+
+   public:
+    /**
+     * @brief Makes a fresh budget
+     *
+     * @param nodeLimit nodes we're allowed to expand
+     * @param deadline when to stop regardless, nothing for never
+     */
+    explicit Budget(
+        size_t nodeLimit,
+        std::optional<std::chrono::steady_clock::time_point> deadline = {})
+        : nodeLimit{nodeLimit}, deadline{deadline} {}
+
+    /**
+     * @brief Asks to expand one more node, and counts it if that's allowed
+     *
+     * @return `true` iff the budget ran out, so the node mustn't be expanded
+     */
+    [[nodiscard]] auto exhausted() -> bool {
+        if (stopped || nodeCount >= nodeLimit) {
+            stopped = true;
+            return true;
+        }
+
+        ++nodeCount;
+        stopped = deadline && nodeCount % CLOCK_INTERVAL == 0 &&
+                  std::chrono::steady_clock::now() >= *deadline;
+        return stopped;
+    }
+
+    /**
+     * @brief Nodes expanded so far
+     *
+     * @return the count
+     */
+    [[nodiscard]] auto getNodeCount() const -> size_t { return nodeCount; }
+
+    /**
+     * @brief Whether the search got cut short
+     *
+     * @return `true` iff the budget ran out at some point
+     */
+    [[nodiscard]] auto wasStopped() const -> bool { return stopped; }
+};
+
+/**
+ * @brief Tie policy: keep every clique of the best size found so far
+ *
+ * Needed when something picks between maximum cliques afterwards,
+ * like modifiedMaxClique does, or when the caller asked for all of them
+ */
+class KeepTies {
+   private:
+    /**
+     * @brief Size of the best clique so far
+     */
+    size_t best{0};
+
+    /**
+     * @brief Every clique of the best size so far, in the order found
+     */
+    std::vector<std::vector<size_t>> maxCliques;
+
+   public:
+    /**
+     * @brief Starts off with nothing kept
+     *
+     * @param vertexCount unused, only here so both tie policies can be made
+     * the same way
+     */
+    explicit KeepTies([[maybe_unused]] size_t vertexCount) {}
+
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = true;
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return best; }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return `true` iff it could at least tie
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return reachableSize >= best;
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (clique.size() > best) {
+            best = clique.size();
+            maxCliques.clear();
+        }
+        if (clique.size() == best) {
+            maxCliques.push_back(clique);
+        }
+    }
+
+    /**
+     * @brief The cliques kept
+     *
+     * @return every clique of the best size, never empty once the search
+     * has started (the empty clique counts)
+     */
+    [[nodiscard]] auto getCliques() const
+        -> const std::vector<std::vector<size_t>>& {
+        return maxCliques;
+    }
+
+    /**
+     * @brief Puts the kept cliques in lexicographic order, without repeats
+     *
+     * Which is how the exact sequential search finds them anyway, this is
+     * for when several threads or a local search recorded them
+     */
+    auto sortUnique() -> void {
+        std::ranges::sort(maxCliques);
+        auto repeats = std::ranges::unique(maxCliques);
+        maxCliques.erase(repeats.begin(), repeats.end());
+    }
+};
+
+/**
+ * @brief Tie policy: only remember the first clique of the best size
+ *
+ * Lets the search skip anything that can only tie, and the one clique it
+ * keeps lives in a buffer that's allocated once, up front
+ */
+class IgnoreTies {
+   private:
+    /**
+     * @brief The best clique so far
+     */
+    std::vector<size_t> best;
+
+   public:
+    /**
+     * @brief Reserves room for the biggest possible clique
+     *
+     * @param vertexCount number of vertices in the graph
+     */
+    explicit IgnoreTies(size_t vertexCount) { best.reserve(vertexCount); }
+
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = false;
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return best.size(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return `true` iff it could beat the best so far
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return reachableSize > bestSize();
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * Copies into the reserved buffer, so this never allocates
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (clique.size() > bestSize()) {
+            best.assign(clique.begin(), clique.end());
+        }
+    }
+
+    /**
+     * @brief The best clique found
+     *
+     * @return the clique
+     */
+    [[nodiscard]] auto getBest() const -> const std::vector<size_t>& {
+        return best;
+    }
+};
+
+/**
+ * @brief Tie policy for the decision version: stop at the first clique of
+ * a given size
+ *
+ * The bound starts out at size - 1, as if a clique that big was already
+ * known, so only branches that could reach the target get explored. Once a
+ * witness turns up the bound jumps to the vertex count, which nothing can
+ * beat, and the rest of the search unwinds without expanding anything
+ */
+class Threshold {
+   private:
+    /**
+     * @brief Size we're looking for, at least 1
+     */
+    size_t target;
+
+    /**
+     * @brief Number of vertices in the graph
+     */
+    size_t vertexCount;
+
+    /**
+     * @brief The first clique of the target size, if there was one yet
+     */
+    std::optional<std::vector<size_t>> witness;
+
+   public:
+    /**
+     * @brief Starts looking
+     *
+     * @param target size we're looking for, at least 1
+     * @param vertexCount number of vertices in the graph
+     */
+    Threshold(size_t target, size_t vertexCount)
+        : target{target}, vertexCount{vertexCount} {}
+
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = false;
+
+    /**
+     * @brief The bound the search prunes against
+     *
+     * @return target - 1 while looking, the vertex count once done
+     */
+    [[nodiscard]] auto bestSize() const -> size_t {
+        return witness ? vertexCount : target - 1;
+    }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return `true` iff there's no witness yet and it could reach the
+     * target
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return reachableSize > bestSize();
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * @param clique the clique, kept if it's the first big enough one
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (!witness && clique.size() >= target) {
+            witness = clique;
+        }
+    }
+
+    /**
+     * @brief The clique found
+     *
+     * @return the first clique of the target size, nothing if there's none
+     */
+    [[nodiscard]] auto getWitness() const
+        -> const std::optional<std::vector<size_t>>& {
+        return witness;
+    }
+};
+
+/**
+ * @brief Tie policy for the k biggest maximal cliques
+ *
+ * Keeps a bounded min-heap of at most k cliques, with the worst one on top.
+ * Once it's full, the bound is the k-th best size instead of the best one,
+ * so the search only goes where something could still make the cut.
+ * Non maximal cliques are skipped, or every top-k list would just be the
+ * maximum clique and its subsets
+ */
+class TopK {
+   private:
+    /**
+     * @brief How many cliques to keep, at least 1
+     */
+    size_t capacity;
+
+    /**
+     * @brief Clique adjacency bits, to check maximality with
+     */
+    const bits::BitMatrix& adjacency;
+
+    /**
+     * @brief Vertices adjacent to a whole clique, for the maximality check
+     */
+    std::vector<bits::Word> extensions;
+
+    /**
+     * @brief The best cliques so far, as a heap with the worst on top
+     */
+    std::vector<std::vector<size_t>> heap;
+
+    /**
+     * @brief Heap order: bigger is better, and among same sized ones the
+     * one found first wins
+     *
+     * Cliques are found in lexicographic order when single threaded, so
+     * that's the same as the lexicographically smaller one winning
+     *
+     * @param lhs a clique
+     * @param rhs another clique
+     *
+     * @return `true` iff lhs is better than rhs
+     */
+    [[nodiscard]] static auto isBetter(const std::vector<size_t>& lhs,
+                                       const std::vector<size_t>& rhs)
+        -> bool {
+        return lhs.size() == rhs.size() ? lhs < rhs : lhs.size() > rhs.size();
+    }
+
+    /**
+     * @brief Whether nothing can be added to a clique
+     *
+     * @param clique the clique
+     *
+     * @return `true` iff no vertex is adjacent to all of it
+     */
+    [[nodiscard]] auto isMaximal(const std::vector<size_t>& clique) -> bool {
+        // The padding bits only matter for the empty clique, which isn't
+        // maximal anyway unless there's no vertices (and no words) at all.
+        // Members aren't in their own rows, so they drop out too
+        std::ranges::fill(extensions, ~bits::Word{0});
+        for (size_t member : clique) {
+            bits::intersect(extensions, adjacency[member], extensions);
+        }
+        return bits::none(extensions);
+    }
+
+   public:
+    /**
+     * @brief Starts with nothing kept
+     *
+     * @param capacity how many cliques to keep, at least 1
+     * @param adjacency symmetric, loopless adjacency bits of the searched
+     * graph, has to outlive this
+     */
+    TopK(size_t capacity, const bits::BitMatrix& adjacency)
+        : capacity{capacity},
+          adjacency{adjacency},
+          extensions(adjacency.getStride()) {
+        heap.reserve(capacity + 1);
+    }
+
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = false;
+
+    /**
+     * @brief Only maximal cliques get recorded, so the search can skip
+     * branches that can't have any, even before there's k of them
+     */
+    static constexpr bool MAXIMAL_ONLY = true;
+
+    /**
+     * @brief The bound the search prunes against
+     *
+     * @return size of the k-th best clique, 0 until there's k of them
+     */
+    [[nodiscard]] auto bestSize() const -> size_t {
+        return heap.size() < capacity ? 0 : heap.front().size();
+    }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return `true` iff it could beat the k-th best
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return reachableSize > bestSize();
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * @param clique the clique, kept if it's maximal and makes the cut
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (!isWorthExploring(clique.size()) || !isMaximal(clique)) {
+            return;
+        }
+
+        heap.push_back(clique);
+        std::ranges::push_heap(heap, isBetter);
+        if (heap.size() > capacity) {
+            std::ranges::pop_heap(heap, isBetter);
+            heap.pop_back();
+        }
+    }
+
+    /**
+     * @brief The cliques kept
+     *
+     * @return up to k maximal cliques, biggest first, same sized ones in
+     * lexicographic order
+     */
+    [[nodiscard]] auto getCliques() const -> std::vector<std::vector<size_t>> {
+        auto cliques = heap;
+        std::ranges::sort(cliques, isBetter);
+        return cliques;
+    }
+};
+
+/**
+ * @brief Tie policies that only record maximal cliques: TopK, and
+ * SharedTies around it
+ */
+template <typename Policy>
+concept MaximalOnly = requires { requires Policy::MAXIMAL_ONLY; };
+
+/**
+ * @brief Tie policy wrapper: one Ties shared by every thread of a search
+ *
+ * The best size is mirrored in an atomic so the pruning checks never lock,
+ * and each thread prunes against what all of them found so far.
+ * Only cliques that could actually be recorded take the lock.
+ *
+ * @tparam Ties KeepTies, IgnoreTies, Threshold or TopK
+ */
+template <typename Ties>
+class SharedTies {
+   private:
+    /**
+     * @brief The wrapped policy, guarded by mutex
+     */
+    Ties& ties;
+
+    /**
+     * @brief Guards ties
+     */
+    std::mutex mutex;
+
+    /**
+     * @brief Copy of ties.bestSize(), readable without the lock
+     */
+    std::atomic<size_t> best{0};
+
+   public:
+    /**
+     * @brief Wraps a Ties, which has to outlive this
+     *
+     * @param ties the policy every thread records into
+     */
+    explicit SharedTies(Ties& ties) : ties{ties}, best{ties.bestSize()} {}
+
+    /**
+     * @brief Whether only maximal cliques get recorded
+     */
+    static constexpr bool MAXIMAL_ONLY = MaximalOnly<Ties>;
+
+    /**
+     * @brief Size of the best clique so far, from any thread
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t {
+        return best.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return same as Ties::isWorthExploring, but against every thread's best
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return Ties::KEEPS_TIES ? reachableSize >= bestSize()
+                                : reachableSize > bestSize();
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (!isWorthExploring(clique.size())) {
+            return;
+        }
+
+        std::scoped_lock lock{mutex};
+        ties.record(clique);
+        best.store(ties.bestSize(), std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Tie and accuracy policy for several searches racing on one graph
+ *
+ * Everyone records into one SharedTies, so they all prune against the best
+ * any of them found. The first search to get to the end without being
+ * stopped has proven there's nothing better (or, keeping ties, found every
+ * tie itself) and calls finish(), after which exhausted() tells the rest of
+ * them to give up.
+ *
+ * @tparam Ties KeepTies or IgnoreTies
+ */
+template <typename Ties>
+class Race {
+   private:
+    /**
+     * @brief Where every search records
+     */
+    SharedTies<Ties> ties;
+
+    /**
+     * @brief Whether someone already finished
+     */
+    std::atomic<bool> finished{false};
+
+   public:
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = Ties::KEEPS_TIES;
+
+    /**
+     * @brief Already thread safe, so a parallel search can use it as is,
+     * both as its ties and its accuracy
+     */
+    static constexpr bool SHAREABLE = true;
+
+    /**
+     * @brief Wraps a Ties, which has to outlive this
+     *
+     * @param ties the policy every search records into
+     */
+    explicit Race(Ties& ties) : ties{ties} {}
+
+    /**
+     * @brief Size of the best clique so far, from any search
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return ties.bestSize(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return same as Ties::isWorthExploring, against every search's best
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return ties.isWorthExploring(reachableSize);
+    }
+
+    /**
+     * @brief Offers a clique
+     *
+     * @param clique the clique, sorted
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        ties.record(clique);
+    }
+
+    /**
+     * @brief Whether the race is over
+     *
+     * @return `true` once anyone called finish()
+     */
+    [[nodiscard]] auto exhausted() const -> bool {
+        return finished.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Ends the race, for a search that ran to the end
+     *
+     * Harmless from a search that was stopped, the race is over by then
+     */
+    auto finish() -> void { finished.store(true, std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Policies every thread of a parallel search can share as they are:
+ * Exact, and Race
+ */
+template <typename Policy>
+concept Shareable = requires { requires Policy::SHAREABLE; };
+
+/**
+ * @brief Tie and accuracy policy for a search that gets interrupted on a
+ * budget, and carried on later
+ *
+ * The callback runs inside the search, at the node where the budget ran
+ * out, while each level's candidates above it are still what that level has
+ * left to branch on. Graph::checkpointedCliques saves them from there.
+ * After that nothing gets recorded or explored, so the search unwinds
+ * straight away, without touching anything the saved levels still cover.
+ *
+ * @tparam Ties any tie policy
+ */
+template <typename Ties>
+class Interruptible {
+   private:
+    /**
+     * @brief The wrapped policy
+     */
+    Ties& ties;
+
+    /**
+     * @brief The budget that decides when
+     */
+    Budget budget;
+
+    /**
+     * @brief What to call when it runs out
+     */
+    std::function<void()> onInterrupt;
+
+   public:
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = Ties::KEEPS_TIES;
+
+    /**
+     * @brief Wraps a Ties, which has to outlive this
+     *
+     * @param ties the policy to record into
+     * @param budget when to interrupt
+     * @param onInterrupt called once, when the budget runs out
+     */
+    Interruptible(Ties& ties, Budget budget, std::function<void()> onInterrupt)
+        : ties{ties}, budget{budget}, onInterrupt{std::move(onInterrupt)} {}
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return ties.bestSize(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return same as Ties::isWorthExploring, `false` once interrupted
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return !budget.wasStopped() && ties.isWorthExploring(reachableSize);
+    }
+
+    /**
+     * @brief Offers a clique, unless interrupted
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        if (!budget.wasStopped()) {
+            ties.record(clique);
+        }
+    }
+
+    /**
+     * @brief Counts one expanded node, calling back if that was the last
+     *
+     * @return `true` iff the budget ran out
+     */
+    [[nodiscard]] auto exhausted() -> bool {
+        if (budget.wasStopped()) {
+            return true;
+        }
+
+        bool stopped = budget.exhausted();
+        if (stopped) {
+            onInterrupt();
+        }
+        return stopped;
+    }
+
+    /**
+     * @brief Whether the search got interrupted
+     *
+     * @return `true` iff the budget ran out at some point
+     */
+    [[nodiscard]] auto wasStopped() const -> bool {
+        return budget.wasStopped();
+    }
+};
+
+/**
+ * @brief Tie policy wrapper for a search over renumbered vertices
+ *
+ * The search sees vertex order[i] as i, this turns its cliques back into
+ * the original vertices before recording them
+ *
+ * @tparam Ties any tie policy
+ */
+template <typename Ties>
+class Renumbered {
+   private:
+    /**
+     * @brief The wrapped policy
+     */
+    Ties& ties;
+
+    /**
+     * @brief Which original vertex each of the search's vertices is
+     */
+    const std::vector<size_t>& order;
+
+    /**
+     * @brief The last clique, renumbered, kept to not allocate every time
+     */
+    std::vector<size_t> renumbered;
+
+   public:
+    /**
+     * @brief Whether cliques that only tie still get recorded
+     */
+    static constexpr bool KEEPS_TIES = Ties::KEEPS_TIES;
+
+    /**
+     * @brief Wraps a Ties, both arguments have to outlive this
+     *
+     * @param ties the policy to record into
+     * @param order the original vertex for each renumbered one
+     */
+    Renumbered(Ties& ties, const std::vector<size_t>& order)
+        : ties{ties}, order{order} {
+        renumbered.reserve(order.size());
+    }
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return ties.bestSize(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return same as Ties::isWorthExploring
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return ties.isWorthExploring(reachableSize);
+    }
+
+    /**
+     * @brief Offers a clique, in renumbered vertices
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        // Most cliques get turned down, no point renumbering those
+        if (!ties.isWorthExploring(clique.size())) {
+            return;
+        }
+
+        renumbered.clear();
+        for (size_t vertex : clique) {
+            renumbered.push_back(order[vertex]);
+        }
+        std::ranges::sort(renumbered);
+        ties.record(renumbered);
+    }
+
+    /**
+     * @brief Sorts the wrapped policy's ties, they come in the search's
+     * order rather than the original one
+     */
+    auto sortUnique() -> void { ties.sortUnique(); }
+};
+
+/**
+ * @brief Tie policy wrapper: calls back whenever the best size goes up
+ *
+ * @tparam Ties KeepTies or IgnoreTies
+ */
+template <typename Ties>
+class ReportImprovements {
+   private:
+    /**
+     * @brief The wrapped policy
+     */
+    Ties& ties;
+
+    /**
+     * @brief What to call with every new best clique
+     */
+    const std::function<void(const std::vector<size_t>&)>& onImprovement;
+
+   public:
+    /**
+     * @brief Wraps a Ties, both arguments have to outlive this
+     *
+     * @param ties the policy to record into
+     * @param onImprovement called with each clique that beats every one
+     * before it, can be empty
+     */
+    ReportImprovements(
+        Ties& ties,
+        const std::function<void(const std::vector<size_t>&)>& onImprovement)
+        : ties{ties}, onImprovement{onImprovement} {}
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return ties.bestSize(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return same as Ties::isWorthExploring
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return ties.isWorthExploring(reachableSize);
+    }
+
+    /**
+     * @brief Offers a clique, and reports it if it's a new best
+     *
+     * @param clique the clique
+     */
+    auto record(const std::vector<size_t>& clique) -> void {
+        bool improves = clique.size() > ties.bestSize();
+        ties.record(clique);
+        if (improves && onImprovement) {
+            onImprovement(clique);
+        }
+    }
+};
+
+}  // namespace clique
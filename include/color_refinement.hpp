@@ -0,0 +1,260 @@
+/**
+ * @file color_refinement.hpp
+ * @brief Colour refinement (1-dimensional Weisfeiler-Leman) of two
+ * colourings at once
+ */
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "bitset.hpp"
+
+/**
+ * @brief Colour refinement on two graphs at once, lhs vertices first and
+ * then rhs, so equal signatures get equal colours on either side
+ *
+ * A vertex's signature is its current colour, then what its neighbours'
+ * colours are. Signatures go in one flat buffer and get renamed to dense
+ * colours by sorting. Colours only ever split, so a round that doesn't
+ * change the number of colours means they're stable.\n
+ * There's two ways to do a round: refine counts the successors and
+ * predecessors of each colour with the bitset kernels, which is quick for
+ * small and dense graphs, and for those every buffer is sized for the most
+ * colours there can be up front, so no round allocates anything.
+ * refineNeighbours lists the neighbours' colours instead, so it only costs
+ * about as much as the edges, whatever the number of colours.\n
+ * Both graphs can be the same one, to compare two colourings of it.
+ *
+ * @tparam Words words per row of the fixed size rows refine takes, or 0
+ * for BitMatrix
+ */
+template <size_t Words>
+class ColorRefinement {
+   private:
+    /**
+     * @brief Colours are shared between both graphs, so there can be twice
+     * as many as either has vertices
+     */
+    static constexpr size_t CLASS_ROWS = 2 * Words * bits::WORD_BITS;
+
+    /**
+     * @brief Vertices of each graph
+     */
+    size_t vertexCount;
+
+    /**
+     * @brief Entries of each signature this round
+     */
+    size_t width{0};
+
+    /**
+     * @brief Every vertex's signature, width entries each, lhs first
+     */
+    std::vector<size_t> signatures;
+
+    /**
+     * @brief Scratch for sorting the signatures
+     */
+    std::vector<size_t> order;
+
+    /**
+     * @brief One row per colour, lhs vertices of that colour
+     */
+    bits::BitRows<Words, CLASS_ROWS> lhsClasses;
+
+    /**
+     * @brief One row per colour, rhs vertices of that colour
+     */
+    bits::BitRows<Words, CLASS_ROWS> rhsClasses;
+
+    /**
+     * @brief Every vertex's colour, lhs first
+     */
+    std::vector<size_t> colors;
+
+    /**
+     * @brief How many colours there are
+     */
+    size_t colorCount{0};
+
+    /**
+     * @brief Counts one graph's successors and predecessors of each colour
+     *
+     * @param offset where the graph's vertices start, 0 or vertexCount
+     * @param classes scratch rows for the graph's colour classes
+     * @param successors the graph's out-neighbour rows
+     * @param predecessors the graph's in-neighbour rows
+     */
+    auto fillSignatures(size_t offset, auto& classes, const auto& successors,
+                        const auto& predecessors) -> void {
+        for (size_t color = 0; color < colorCount; ++color) {
+            std::ranges::fill(classes[color], bits::Word{0});
+        }
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            classes.set(colors[offset + vertex], vertex);
+        }
+
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            auto row = signature(offset + vertex);
+            row[0] = colors[offset + vertex];
+            for (size_t color = 0; color < colorCount; ++color) {
+                row[1 + color] =
+                    bits::intersectCount(successors[vertex], classes[color]);
+                row[1 + colorCount + color] =
+                    bits::intersectCount(predecessors[vertex], classes[color]);
+            }
+        }
+    }
+
+    /**
+     * @brief Lists one graph's neighbour colours, sorted, padded to the
+     * signature width
+     *
+     * @param offset where the graph's vertices start, 0 or vertexCount
+     * @param neighbours the graph's adjacency lists
+     */
+    auto fillNeighbourSignatures(
+        size_t offset, const std::vector<std::vector<size_t>>& neighbours)
+        -> void {
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            auto row = signature(offset + vertex);
+            row[0] = colors[offset + vertex];
+            auto listed = row.subspan(1);
+            std::ranges::transform(
+                neighbours[vertex], listed.begin(),
+                [&](size_t other) { return colors[offset + other]; });
+            auto used = listed.first(neighbours[vertex].size());
+            std::ranges::sort(used);
+            std::ranges::fill(listed.subspan(used.size()),
+                              std::numeric_limits<size_t>::max());
+        }
+    }
+
+   public:
+    /**
+     * @brief Gets the buffers ready, nothing's coloured yet
+     *
+     * @param vertexCount vertices of each graph, the same for both
+     */
+    explicit ColorRefinement(size_t vertexCount)
+        : vertexCount{vertexCount},
+          order(2 * vertexCount),
+          lhsClasses{CLASS_ROWS, vertexCount},
+          rhsClasses{CLASS_ROWS, vertexCount},
+          colors(2 * vertexCount) {
+        if constexpr (Words != 0) {
+            signatures.reserve(2 * vertexCount * (1 + 4 * vertexCount));
+        }
+    }
+
+    /**
+     * @brief Makes room for signatures of some width, to fill in with
+     * signature and then recolor, for the starting colours
+     *
+     * @param signatureWidth entries per signature
+     */
+    auto startSignatures(size_t signatureWidth) -> void {
+        width = signatureWidth;
+        signatures.resize(2 * vertexCount * width);
+    }
+
+    /**
+     * @brief A vertex's signature
+     *
+     * @param vertex lhs vertices first, then rhs ones
+     *
+     * @return its entries
+     */
+    [[nodiscard]] auto signature(size_t vertex) -> std::span<size_t> {
+        return std::span<size_t>{signatures}.subspan(vertex * width, width);
+    }
+
+    /**
+     * @brief Renames the signatures to dense colours, in signature order
+     *
+     * @return the number of colours
+     */
+    auto recolor() -> size_t {
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, [&](size_t first, size_t second) {
+            return std::ranges::lexicographical_compare(signature(first),
+                                                        signature(second));
+        });
+
+        colorCount = 0;
+        for (size_t i = 0; i < order.size(); ++i) {
+            if (i == 0 || !std::ranges::equal(signature(order[i - 1]),
+                                              signature(order[i]))) {
+                ++colorCount;
+            }
+            colors[order[i]] = colorCount - 1;
+        }
+        return colorCount;
+    }
+
+    /**
+     * @brief One round, counting neighbours of each colour with bitsets
+     *
+     * @param lhsSuccessors lhs out-neighbour rows, Words wide
+     * @param lhsPredecessors lhs in-neighbour rows, Words wide
+     * @param rhsSuccessors rhs out-neighbour rows, Words wide
+     * @param rhsPredecessors rhs in-neighbour rows, Words wide
+     *
+     * @return the new number of colours
+     */
+    auto refine(const auto& lhsSuccessors, const auto& lhsPredecessors,
+                const auto& rhsSuccessors, const auto& rhsPredecessors)
+        -> size_t {
+        // Big graphs only get their class rows once something needs them
+        if constexpr (Words == 0) {
+            if (lhsClasses.getSize() == 0) {
+                lhsClasses = bits::BitMatrix{2 * vertexCount, vertexCount};
+                rhsClasses = bits::BitMatrix{2 * vertexCount, vertexCount};
+            }
+        }
+
+        startSignatures(1 + (2 * colorCount));
+        fillSignatures(0, lhsClasses, lhsSuccessors, lhsPredecessors);
+        fillSignatures(vertexCount, rhsClasses, rhsSuccessors,
+                       rhsPredecessors);
+        return recolor();
+    }
+
+    /**
+     * @brief One round, listing the neighbours' colours, for undirected
+     * graphs that are too big or sparse to count colours with bitsets
+     *
+     * @param lhsNeighbours lhs adjacency lists, every edge both ways
+     * @param rhsNeighbours rhs adjacency lists, every edge both ways
+     *
+     * @return the new number of colours
+     */
+    auto refineNeighbours(
+        const std::vector<std::vector<size_t>>& lhsNeighbours,
+        const std::vector<std::vector<size_t>>& rhsNeighbours) -> size_t {
+        size_t maxDegree = 0;
+        for (const auto* neighbours : {&lhsNeighbours, &rhsNeighbours}) {
+            for (const auto& list : *neighbours) {
+                maxDegree = std::max(maxDegree, list.size());
+            }
+        }
+
+        startSignatures(1 + maxDegree);
+        fillNeighbourSignatures(0, lhsNeighbours);
+        fillNeighbourSignatures(vertexCount, rhsNeighbours);
+        return recolor();
+    }
+
+    /**
+     * @brief The colours from the last recolor
+     *
+     * @return every vertex's colour, lhs first
+     */
+    [[nodiscard]] auto getColors() const -> std::span<const size_t> {
+        return colors;
+    }
+};
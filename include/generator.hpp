@@ -0,0 +1,256 @@
+/**
+ * @file generator.hpp
+ * @brief Minimal coroutine generator, until we get std::generator
+ */
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+/**
+ * @brief Lazy sequence of values, produced by a coroutine with co_yield
+ *
+ * Nothing runs until the first begin(), and every ++ runs the coroutine
+ * just up to its next co_yield, so consumers can stop whenever they like.
+ * Single pass, move only.
+ *
+ * @tparam T the yielded type
+ */
+template <typename T>
+class Generator {
+   public:
+    /**
+     * @brief Coroutine side of the generator, the name's fixed by the
+     * standard
+     */
+    struct promise_type {
+        /**
+         * @brief The value from the last co_yield
+         *
+         * Points into the coroutine frame, which stays put while suspended
+         */
+        const T* current{nullptr};
+
+        /**
+         * @brief Whatever the coroutine threw, rethrown to the consumer
+         */
+        std::exception_ptr exception;
+
+        /**
+         * @brief Makes the Generator handed back to the caller
+         *
+         * @return the generator
+         */
+        auto get_return_object() -> Generator {
+            return Generator{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        /**
+         * @brief Start suspended, so nothing happens before begin()
+         *
+         * @return always suspend
+         */
+        static auto initial_suspend() noexcept -> std::suspend_always {
+            return {};
+        }
+
+        /**
+         * @brief Stay suspended at the end, so done() can be checked
+         *
+         * @return always suspend
+         */
+        static auto final_suspend() noexcept -> std::suspend_always {
+            return {};
+        }
+
+        /**
+         * @brief Handles co_yield
+         *
+         * @param value the yielded value, temporaries live until resumed
+         *
+         * @return always suspend
+         */
+        auto yield_value(const T& value) noexcept -> std::suspend_always {
+            current = std::addressof(value);
+            return {};
+        }
+
+        /**
+         * @brief Handles co_return
+         */
+        static auto return_void() noexcept -> void {}
+
+        /**
+         * @brief Keeps exceptions for the consumer
+         */
+        auto unhandled_exception() noexcept -> void {
+            exception = std::current_exception();
+        }
+    };
+
+    /**
+     * @brief Input iterator over the yielded values
+     */
+    class Iterator {
+       private:
+        /**
+         * @brief The generator's coroutine
+         */
+        std::coroutine_handle<promise_type> handle;
+
+       public:
+        /**
+         * @brief Iterator trait
+         */
+        using iterator_category = std::input_iterator_tag;
+
+        /**
+         * @brief Iterator trait
+         */
+        using difference_type = std::ptrdiff_t;
+
+        /**
+         * @brief Iterator trait
+         */
+        using value_type = T;
+
+        /**
+         * @brief Default constructible, as iterators should be
+         */
+        Iterator() = default;
+
+        /**
+         * @brief Iterator over a running coroutine
+         *
+         * @param handle the coroutine
+         */
+        explicit Iterator(std::coroutine_handle<promise_type> handle)
+            : handle{handle} {}
+
+        /**
+         * @brief The current value
+         *
+         * @return the value from the last co_yield
+         */
+        [[nodiscard]] auto operator*() const -> const T& {
+            return *handle.promise().current;
+        }
+
+        /**
+         * @brief Runs the coroutine up to its next co_yield
+         *
+         * @return this
+         */
+        auto operator++() -> Iterator& {
+            handle.resume();
+            if (handle.promise().exception) {
+                std::rethrow_exception(handle.promise().exception);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Same as the prefix one, input iterators don't keep copies
+         */
+        auto operator++(int) -> void { ++*this; }
+
+        /**
+         * @brief Whether the coroutine finished
+         *
+         * @param sentinel end()
+         *
+         * @return `true` iff there's nothing left
+         */
+        [[nodiscard]] auto operator==(
+            [[maybe_unused]] std::default_sentinel_t sentinel) const -> bool {
+            return handle.done();
+        }
+    };
+
+   private:
+    /**
+     * @brief The coroutine, null once moved from
+     */
+    std::coroutine_handle<promise_type> handle;
+
+    /**
+     * @brief Only made by promise_type
+     *
+     * @param handle the coroutine
+     */
+    explicit Generator(std::coroutine_handle<promise_type> handle)
+        : handle{handle} {}
+
+   public:
+    /**
+     * @brief No copying, there's only one coroutine
+     */
+    Generator(const Generator&) = delete;
+
+    /**
+     * @brief No copying, there's only one coroutine
+     *
+     * @return nothing, it's deleted
+     */
+    auto operator=(const Generator&) -> Generator& = delete;
+
+    /**
+     * @brief Takes over another generator's coroutine
+     *
+     * @param other the generator to empty
+     */
+    Generator(Generator&& other) noexcept
+        : handle{std::exchange(other.handle, {})} {}
+
+    /**
+     * @brief Takes over another generator's coroutine
+     *
+     * @param other the generator to empty
+     *
+     * @return this
+     */
+    auto operator=(Generator&& other) noexcept -> Generator& {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the coroutine, wherever it's suspended
+     */
+    ~Generator() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    /**
+     * @brief Runs the coroutine up to its first co_yield
+     *
+     * Only call this once
+     *
+     * @return iterator at the first value
+     */
+    [[nodiscard]] auto begin() -> Iterator {
+        Iterator iterator{handle};
+        ++iterator;
+        return iterator;
+    }
+
+    /**
+     * @brief The end of the sequence
+     *
+     * @return a sentinel
+     */
+    [[nodiscard]] static auto end() -> std::default_sentinel_t {
+        return std::default_sentinel;
+    }
+};
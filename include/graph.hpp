@@ -2,14 +2,244 @@
  * @file graph.hpp
  * @brief Graph representation definitions
  */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "bitset.hpp"
+#include "certificate.hpp"
+#include "clique_counting.hpp"
+#include "clique_policies.hpp"
+#include "generator.hpp"
+#include "graph_statistics.hpp"
+#include "tree_estimate.hpp"
+#include "triangles.hpp"
+
 /**
  * @brief Little enum for choosing between approximate and exact algorithms
+ *
+ * AUTO estimates the exact search first (see Graph::estimateMaxClique) and
+ * only runs it if it fits in Graph::getExactBudget, otherwise it's the
+ * approximation. Anything that isn't a clique search takes it as EXACT.
+ */
+enum class AlgorithmAccuracy { APPROXIMATE, EXACT, AUTO };
+
+/**
+ * @brief Which exact algorithm Graph::maxClique runs
+ *
+ * - AUTO: whatever Graph::planMaxClique picks from the graph's statistics
+ * (COMPLEMENT for a sparse complement, RUSSIAN_DOLL for a sparse graph,
+ * BRANCH_AND_BOUND for everything else)
+ * - BRANCH_AND_BOUND: coloring bounded search, the only one that splits
+ * its own tree between threads. Skips branches that are symmetric to
+ * earlier ones, see Graph::branchOnOrbits
+ * - RUSSIAN_DOLL: clique::russianDollSearch, usually better on sparse
+ * graphs with small cliques
+ * - COMPLEMENT: clique::maximumIndependentSet on the complement, however
+ * dense the complement is
+ * - PORTFOLIO: races several of the others on their own threads, the
+ * first branch and bound on as many as asked for, see
+ * Graph::portfolioCliques. The only one other than BRANCH_AND_BOUND that
+ * can keep ties, for maxSubgraph.
+ */
+enum class CliqueEngine {
+    AUTO,
+    BRANCH_AND_BOUND,
+    RUSSIAN_DOLL,
+    COMPLEMENT,
+    PORTFOLIO
+};
+
+/**
+ * @brief Reads an engine's name, the way the tools take it for "--engine"
+ *
+ * @param name one of "auto", "branch-and-bound", "russian-doll",
+ * "complement" or "portfolio"
+ *
+ * @return the engine, nothing for a name it doesn't know
+ */
+[[nodiscard]] auto parseCliqueEngine(std::string_view name)
+    -> std::optional<CliqueEngine>;
+
+/**
+ * @brief How a search holds the graph, see SearchPlan
+ *
+ * - DENSE: the weighted adjacency matrix itself
+ * - FIXED_BITSET: bit rows of a compile time width, for up to
+ * bits::MAX_FIXED_BITS vertices
+ * - BITSET: bit rows of any width, with the dispatched kernels
+ * - SPARSE: neighbour lists
+ */
+enum class GraphStorage { DENSE, FIXED_BITSET, BITSET, SPARSE };
+
+/**
+ * @brief Which order a search goes through the vertices in, see SearchPlan
+ *
+ * - NATURAL: 0, 1, 2...
+ * - DEGREE: biggest degree first
+ * - DEGENERACY: smallest-last, see clique::degeneracyOrder
+ */
+enum class VertexOrder { NATURAL, DEGREE, DEGENERACY };
+
+/**
+ * @brief What the planner decided for one operation, and why
+ *
+ * See Graph::planMaxClique, Graph::planMaxSubgraph and
+ * Graph::planIsomorphism. Printing one gives a couple of lines for
+ * "--explain".
+ */
+struct SearchPlan {
+    /**
+     * @brief What's being planned, like "maxClique"
+     */
+    std::string operation;
+
+    /**
+     * @brief The numbers the plan was made from
+     */
+    clique::GraphStatistics statistics;
+
+    /**
+     * @brief Exact or approximate, with AUTO already settled
+     */
+    AlgorithmAccuracy accuracy;
+
+    /**
+     * @brief The exact search that runs, never AUTO. Nothing for
+     * approximate searches and isomorphism checks.
+     */
+    std::optional<CliqueEngine> engine;
+
+    /**
+     * @brief How the search holds the graph
+     */
+    GraphStorage storage;
+
+    /**
+     * @brief Which order the search goes through the vertices in
+     */
+    VertexOrder order;
+
+    /**
+     * @brief The deciding reason, in a few words
+     */
+    std::string reason;
+
+    /**
+     * @brief What the local search behind AUTO's estimate found, the best
+     * clique, or every tie for searches that keep them. Empty if there was
+     * no estimate. An approximate search starts from these instead of
+     * running the same local search again.
+     */
+    std::vector<std::vector<size_t>> incumbents;
+
+    /**
+     * @brief How long the exact search may run, for AUTO with an engine
+     * that can't be estimated. Once it's up the search stops with the best
+     * it has, incumbents included. Nothing for no limit.
+     */
+    std::optional<std::chrono::nanoseconds> timeLimit;
+};
+
+/**
+ * @brief Prints a plan, statistics on the first line and choices on the
+ * second
+ *
+ * @param outputStream the stream to write to
+ * @param plan the plan
+ *
+ * @return the outputStream
+ */
+auto operator<<(std::ostream& outputStream, const SearchPlan& plan)
+    -> std::ostream&;
+
+/**
+ * @brief How long Graph::anytimeMaxClique may search
+ *
+ * Both limits are optional, with neither set the search runs to the end
  */
-enum class AlgorithmAccuracy { APPROXIMATE, EXACT };
+struct SearchBudget {
+    /**
+     * @brief Wall time allowed, checked every few dozen nodes
+     */
+    std::optional<std::chrono::steady_clock::duration> timeLimit;
+
+    /**
+     * @brief Search tree nodes allowed
+     */
+    std::optional<size_t> nodeLimit;
+};
+
+/**
+ * @brief What a max clique search can start from, see Graph::maxClique
+ *
+ * Both parts are optional, an empty hint is the same as none
+ */
+struct CliqueHint {
+    /**
+     * @brief A clique that's already known, in any order, e.g. the answer
+     * from before a small edit, or from a heuristic. The search starts with
+     * it as the best so far, so it only looks for bigger ones.
+     */
+    std::vector<size_t> clique;
+
+    /**
+     * @brief The order for the branch and bound to go through the
+     * vertices, each of them exactly once. Empty keeps 0, 1, 2...
+     */
+    std::vector<size_t> order;
+};
+
+/**
+ * @brief Where a long exact search saves its state, and where it picks up
+ * from, see Graph::checkpointedCliques
+ */
+struct SearchCheckpoint {
+    /**
+     * @brief File the state goes to every interval, and once more at the
+     * end. Empty for nowhere.
+     */
+    std::string savePath;
+
+    /**
+     * @brief File a run with the same graph and search saved earlier, to
+     * carry on from. Empty to start from scratch.
+     */
+    std::string resumePath;
+
+    /**
+     * @brief Search time between two saves
+     */
+    std::chrono::milliseconds interval{std::chrono::minutes{1}};
+};
+
+/**
+ * @brief What Graph::anytimeMaxClique came back with
+ */
+struct AnytimeClique {
+    /**
+     * @brief Best clique found, sorted
+     */
+    std::vector<size_t> clique;
+
+    /**
+     * @brief Whether the search finished, i.e. clique is a maximum one
+     */
+    bool isOptimal;
+
+    /**
+     * @brief Search tree nodes expanded
+     */
+    size_t nodeCount;
+};
 
 /**
  * @brief Class that represents a graph as a matrix (vector of vectors) of
@@ -37,31 +267,544 @@ class Graph {
     std::vector<std::vector<int>> adjacencyMatrix;
 
     /**
-     * @brief constant used for finding estimate in maxClique.
+     * @brief Bit-packed support of the adjacency matrix
+     *
+     * Bit j of row i is set iff there's at least one i->j edge
+     */
+    bits::BitMatrix successorBits;
+
+    /**
+     * @brief Transpose of successorBits
+     *
+     * Bit j of row i is set iff there's at least one j->i edge
+     */
+    bits::BitMatrix predecessorBits;
+
+    /**
+     * @brief Fills successorBits and predecessorBits from the adjacency matrix
+     */
+    auto buildAdjacencyBits() -> void;
+
+    /**
+     * @brief Builds the undirected, loopless adjacency used by clique search
+     *
+     * @tparam Adjacency clique::MutualAdjacency (plain cliques) or
+     * clique::EitherAdjacency (modified cliques)
+     * @param adjacency where to write it, a BitMatrix or FixedBitMatrix with
+     * vertexCount rows
+     */
+    template <typename Adjacency>
+    auto cliqueAdjacency(auto& adjacency) const -> void;
+
+    /**
+     * @brief Local search steps the approximate searches get per vertex
+     */
+    static constexpr size_t LOCAL_SEARCH_STEPS_PER_VERTEX = 10;
+
+    /**
+     * @brief Local search steps even tiny graphs get
+     */
+    static constexpr size_t LOCAL_SEARCH_MIN_STEPS = 1000;
+
+    /**
+     * @brief Seed for the approximate searches, fixed so they're reproducible
+     */
+    static constexpr std::uint64_t LOCAL_SEARCH_SEED = 0x5EED;
+
+    /**
+     * @brief Random walks estimateCliqueSearch takes
+     *
+     * A walk is about as long as the max clique, so even a few hundred of
+     * them are a few milliseconds on graphs that take minutes
+     */
+    static constexpr size_t ESTIMATE_PROBES = 512;
+
+    /**
+     * @brief How long AlgorithmAccuracy::AUTO lets the exact search take,
+     * unless setExactBudget says otherwise
+     */
+    static constexpr std::chrono::seconds DEFAULT_EXACT_BUDGET{5};
+
+    /**
+     * @brief See setExactBudget
+     */
+    std::chrono::nanoseconds exactBudget{DEFAULT_EXACT_BUDGET};
+
+    /**
+     * @brief Estimates the exact clique search, see clique::estimateTreeSize
+     *
+     * The target comes from a quick local search, the same one the
+     * approximation runs, since the real search usually gets that far
+     * early on
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper, only whether it keeps ties matters
+     * @param quick where the local search's cliques go, fresh
+     *
+     * @return the estimate
+     */
+    template <typename Adjacency, typename Ties>
+    [[nodiscard]] auto estimateCliqueSearch(Ties& quick) const
+        -> clique::TreeEstimate;
+
+    /**
+     * @brief What AlgorithmAccuracy::AUTO turns out to be for a search
+     *
+     * The estimate is of the branch and bound's tree. The portfolio ends no
+     * later than its own branch and bound, give or take the cores its
+     * entrants share, and the Russian doll search only gets picked where
+     * it's expected to beat the branch and bound, so for both that's an
+     * upper bound. COMPLEMENT isn't estimated at all, its branch-and-reduce
+     * has nothing a tree estimate fits: it's always EXACT, and the planner
+     * gives it exactBudget as its SearchPlan::timeLimit instead, with the
+     * local search's cliques to fall back on.
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper
+     * @param accuracy what the caller asked for
+     * @param engine the exact search that would run, never AUTO
+     * @param incumbents where the estimate's local search cliques go, see
+     * SearchPlan::incumbents
+     *
+     * @return accuracy as it is, unless it's AUTO: then EXACT if the
+     * estimate fits in exactBudget or there's no estimate, and APPROXIMATE
+     * if it doesn't
+     */
+    template <typename Adjacency, typename Ties>
+    [[nodiscard]] auto resolveAccuracy(
+        AlgorithmAccuracy accuracy, CliqueEngine engine,
+        std::vector<std::vector<size_t>>& incumbents) const
+        -> AlgorithmAccuracy;
+
+    /**
+     * @brief Density up to which the planner prefers the Russian doll
+     * search over the branch and bound
+     *
+     * Below it the coloring hardly prunes more than the dolls do, and costs
+     * a lot more per node
+     */
+    static constexpr double RUSSIAN_DOLL_DENSITY_THRESHOLD = 0.05;
+
+    /**
+     * @brief The planner behind searchCliques, planMaxClique and
+     * planMaxSubgraph
+     *
+     * An approximate search needs no engine. Otherwise the engine gets
+     * picked first, and then AUTO accuracy settled for it, see
+     * resolveAccuracy. Given the statistics, in order:
+     * - an engine other than AUTO is kept, except that only
+     * BRANCH_AND_BOUND and PORTFOLIO can keep ties
+     * - COMPLEMENT, on neighbour lists of the complement, if that's at most
+     * COMPLEMENT_DENSITY_THRESHOLD dense
+     * - RUSSIAN_DOLL, in degeneracy order, if the graph is at most
+     * RUSSIAN_DOLL_DENSITY_THRESHOLD dense, the search is single threaded
+     * and there's no vertex order to keep
+     * - BRANCH_AND_BOUND otherwise, by degree when it's multithreaded (it
+     * finds big cliques early that way, and the threads share them), and
+     * in the natural order otherwise, so a single thread still gives the
+     * lexicographically first maximum clique
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper
+     * @param operation what to call it in the plan
+     * @param accuracy the accuracy, AUTO gets settled by resolveAccuracy
+     * once there's an engine
+     * @param engine what the caller asked for
+     * @param threadCount threads for the exact search
+     * @param ordered whether the caller gave a vertex order of its own
+     * @param symmetryRounds see clique::measureStatistics, searches pass 0
+     * since the branch and bound finds orbits on its own anyway
+     *
+     * @return the plan
+     */
+    template <typename Adjacency, typename Ties>
+    [[nodiscard]] auto planCliqueSearch(std::string operation,
+                                        AlgorithmAccuracy accuracy,
+                                        CliqueEngine engine,
+                                        size_t threadCount, bool ordered,
+                                        size_t symmetryRounds) const
+        -> SearchPlan;
+
+    /**
+     * @brief The plan for modifiedMaxClique
+     *
+     * planCliqueSearch for keeping ties, except that a single threaded
+     * exact search goes through clique::heaviestMaxClique on the weights,
+     * which does the tie-break as it goes
+     *
+     * @param operation what to call it in the plan
+     * @param accuracy see modifiedMaxClique
+     * @param threadCount see modifiedMaxClique
+     * @param engine see modifiedMaxClique
+     * @param symmetryRounds see planCliqueSearch
+     *
+     * @return the plan
+     */
+    [[nodiscard]] auto planModifiedSearch(std::string operation,
+                                          AlgorithmAccuracy accuracy,
+                                          size_t threadCount,
+                                          CliqueEngine engine,
+                                          size_t symmetryRounds) const
+        -> SearchPlan;
+
+    /**
+     * @brief Every vertex, biggest degree first, ties by number
+     *
+     * @param adjacency adjacency from cliqueAdjacency
+     *
+     * @return the order
      */
-    static constexpr size_t ESTIMATE_MULTIPLIER = 10;
+    [[nodiscard]] static auto degreeOrder(const bits::BitMatrix& adjacency)
+        -> std::vector<size_t>;
 
     /**
      * @brief Helper for maxClique, used for recursion.
      *
-     * @param currentVertex Current vertex to check.
+     * Candidates are kept as bitsets, one row of candidateStack per depth,
+     * so extending the clique is just `candidates & row`.\n
+     * Branches that can't beat (or tie, if ties are kept) the best clique so
+     * far, going by a greedy coloring of the candidates, get skipped. So do
+     * branches with no maximal cliques, for ties that only record those
+     * (see clique::isDominatedBranch).\n
+     * Both matrices are either FixedBitMatrix (small graphs, sizes known at
+     * compile time) or BitMatrix (everything else).
+     *
+     * @tparam Accuracy clique::Exact or clique::Budget
+     * @tparam Ties clique::KeepTies or clique::IgnoreTies, possibly wrapped
+     * @param adjacency Symmetric adjacency to search, see cliqueAdjacency.
+     * @param candidateStack Scratch space, (vertexCount + 3) rows as wide as
+     * adjacency's. Row currentClique.size() holds the vertices that can still
+     * extend currentClique.
      * @param currentClique Clique to check.
-     * @param maxCliques Maximum cliques of the graph.
-     * @param estimation To check if an estimation of max clique is
-     * required.
-     * @param currentExecution Keeps track of the current execution. Used for
-     * estimation.
-     * @param executionLimit Maximum executions allowed. Used for estimation.
-     * @param adajcencyFunction Checks if a vertex is adjacent to all the
-     * vertices in the clique.
-     */
-    auto maxCliqueHelper(size_t currentVertex,
-                         std::vector<size_t>& currentClique,
-                         std::vector<std::vector<size_t>>& maxCliques,
-                         AlgorithmAccuracy accuracy, size_t& currentExecution,
-                         size_t executionLimit, auto adjacencyFunction) const
+     * @param ties Keeps track of the best clique(s).
+     * @param accuracy Decides when to give up early.
+     */
+    template <typename Accuracy, typename Ties>
+    auto maxCliqueHelper(const auto& adjacency, auto& candidateStack,
+                         std::vector<size_t>& currentClique, Ties& ties,
+                         Accuracy& accuracy) const -> void;
+
+    /**
+     * @brief Shared driver for maxClique and modifiedMaxClique
+     *
+     * Hands over to localSearchCliques or runCliqueSearch, depending on
+     * accuracy, or to another engine when a single exact maximum is
+     * wanted. Searches that keep ties get runCliqueSearch, unless they ask
+     * for the portfolio.
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper
+     * @param accuracy whether to cap the search
+     * @param threadCount threads for an exact search, see
+     * searchCliquesInParallel
+     * @param engine which exact search
+     * @param hint where to start from, already checked
+     *
+     * @return the tie policy, holding whatever it kept
+     */
+    template <typename Adjacency, typename Ties>
+    [[nodiscard]] auto searchCliques(
+        AlgorithmAccuracy accuracy, size_t threadCount,
+        CliqueEngine engine = CliqueEngine::AUTO,
+        const CliqueHint& hint = {}) const -> Ties;
+
+    /**
+     * @brief searchCliques, following a plan that's already made
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper, the same as the plan's
+     * @param plan from planCliqueSearch with the same Adjacency and Ties,
+     * or planModifiedSearch
+     * @param threadCount the plan's thread count
+     * @param hint where to start from, already checked, and planned with
+     *
+     * @return the tie policy, holding whatever it kept
+     */
+    template <typename Adjacency, typename Ties>
+    [[nodiscard]] auto searchCliques(const SearchPlan& plan,
+                                     size_t threadCount,
+                                     const CliqueHint& hint = {}) const
+        -> Ties;
+
+    /**
+     * @brief Exact clique search that saves itself as it goes
+     *
+     * The branch and bound on one thread, over a stack of frontier tasks
+     * (subtrees nobody's been through yet, see clique::FrontierTask) that
+     * starts with the whole tree. Every checkpoint.interval the search gets
+     * interrupted, with clique::Interruptible, and whatever each level of the
+     * search tree still had left becomes a task of its own. Then the tasks and
+     * the best cliques so far get saved, and the search carries on from the
+     * deepest task.\n
+     * Tasks come off the stack in the same order the plain search would get
+     * to them, so an interrupted (and resumed) search finds the same cliques
+     * as one that never stopped.
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties KeepTies, IgnoreTies or HeaviestTies. The ones with a
+     * getBest() only save that one clique.
+     * @param ties where the cliques go
+     * @param checkpoint where to save to and resume from
+     * @param kind which search this is, to not resume some other one
+     *
+     * @throws std::invalid_argument if the state to resume from can't be
+     * read, is from a different graph or search, or has an incumbent or a
+     * task that isn't a clique of this graph
+     * @throws std::runtime_error if the state can't be saved
+     */
+    template <typename Adjacency, typename Ties>
+    auto checkpointedCliques(Ties& ties, const SearchCheckpoint& checkpoint,
+                             const std::string& kind) const -> void;
+
+    /**
+     * @brief modifiedMaxClique, following a plan that's already made
+     *
+     * @param plan from planModifiedSearch
+     * @param threadCount the plan's thread count
+     *
+     * @return Vector of vertices that form the maximum clique.
+     */
+    [[nodiscard]] auto modifiedMaxClique(const SearchPlan& plan,
+                                         size_t threadCount) const
+        -> std::vector<size_t>;
+
+    /**
+     * @brief The tie-break of modifiedMaxClique
+     *
+     * @param maxCliques every maximum clique, sorted
+     *
+     * @return the one with the most connections, then edges, then the first
+     */
+    [[nodiscard]] auto heaviestClique(
+        const std::vector<std::vector<size_t>>& maxCliques) const
+        -> std::vector<size_t>;
+
+    /**
+     * @brief maxSubgraph from a clique of the modular product
+     *
+     * @param rhs the other graph
+     * @param productClique the clique, from modularProduct(rhs)
+     *
+     * @return the subgraph induced by the clique's pairs of vertices
+     */
+    [[nodiscard]] auto commonSubgraph(
+        const Graph& rhs, const std::vector<size_t>& productClique) const
+        -> Graph;
+
+    /**
+     * @brief Makes sure a hint fits this graph
+     *
+     * @param hint the hint
+     *
+     * @throws std::invalid_argument see the warm started maxClique
+     */
+    auto checkHint(const CliqueHint& hint) const -> void;
+
+    /**
+     * @brief Approximate clique search, see clique::localSearch
+     *
+     * Every maximal clique the local search stops at gets offered to ties,
+     * sorted
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper
+     * @param ties where the cliques go
+     */
+    template <typename Adjacency, typename Ties>
+    auto localSearchCliques(Ties& ties) const -> void;
+
+    /**
+     * @brief Complement density up to which complementCliques takes over
+     * from the clique search
+     *
+     * On random graphs the two break even somewhere around 0.15, and below
+     * 0.05 the independent set search is orders of magnitude faster
+     */
+    static constexpr double COMPLEMENT_DENSITY_THRESHOLD = 0.1;
+
+    /**
+     * @brief Exact max clique as a maximum independent set of the
+     * complement graph, see clique::maximumIndependentSet
+     *
+     * Without ties, it only looks for cliques bigger than what ties already
+     * has, and a time limit stops it with the biggest it found by then.
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper, only one clique gets recorded so it
+     * shouldn't keep ties
+     * @param ties where the clique goes
+     * @param maxDensity the most edges the complement can have, as a
+     * fraction of all possible ones, COMPLEMENT_DENSITY_THRESHOLD for the
+     * automatic choice
+     * @param timeLimit how long it may search, nothing for no limit. Only
+     * searches without ties can be stopped, the rest ignore it.
+     *
+     * @return `false` if the complement was too dense, and nothing was done
+     */
+    template <typename Adjacency, typename Ties>
+    auto complementCliques(
+        Ties& ties, double maxDensity,
+        std::optional<std::chrono::nanoseconds> timeLimit = {}) const -> bool;
+
+    /**
+     * @brief Adjacency lists of the complement, self-loops left out
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @param maxDensity see complementCliques
+     *
+     * @return the lists, or nothing if the complement was too dense
+     */
+    template <typename Adjacency>
+    [[nodiscard]] auto complementLists(double maxDensity) const
+        -> std::optional<std::vector<std::vector<size_t>>>;
+
+    /**
+     * @brief Complement density up to which portfolioCliques still enters
+     * the independent set search
+     *
+     * Past that it hardly ever wins, and the lists alone take as much memory
+     * as a matrix of size_t
+     */
+    static constexpr double PORTFOLIO_COMPLEMENT_DENSITY = 0.5;
+
+    /**
+     * @brief Exact clique search racing several engines
+     *
+     * The entrants are the branch and bound over the vertices as they are,
+     * on threadCount threads, again on one thread with the highest degrees
+     * first, and, when ties aren't kept, clique::russianDollSearch and
+     * clique::maximumIndependentSet on the complement (if it's at most
+     * PORTFOLIO_COMPLEMENT_DENSITY dense).
+     * They share a clique::Race, so every clique found prunes all of them,
+     * and the first one done stops the rest. That makes it about as fast as
+     * the best engine for the graph, times the number of entrants sharing a
+     * core.\n
+     * The clique that comes out is *a* maximum one, depending on timing.
+     * With ties kept only the branch and bounds enter, and any one of them
+     * finishing means it found every tie itself.
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties KeepTies or IgnoreTies
+     * @param ties where the cliques go
+     * @param threadCount threads for the first branch and bound, see
+     * searchCliquesInParallel
+     * @param order the first branch and bound's vertex order, see
+     * runCliqueSearch
+     */
+    template <typename Adjacency, typename Ties>
+    auto portfolioCliques(Ties& ties, size_t threadCount,
+                          const std::vector<size_t>& order = {}) const -> void;
+
+    /**
+     * @brief Runs a whole clique search with the given policies
+     *
+     * Picks the row storage by vertex count, builds the adjacency, then runs
+     * maxCliqueHelper from the empty clique
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     * @tparam Ties see maxCliqueHelper
+     * @tparam Accuracy see maxCliqueHelper
+     * @param ties where the cliques go, kept ties might come out of order
+     * if there's an order
+     * @param accuracy decides when to give up early
+     * @param threadCount threads, only used with clique::Exact
+     * @param order a permutation of the vertices: the search runs over them
+     * renumbered, so that vertex order[i] comes i-th. Empty keeps them as
+     * they are.
+     * @param orbits from cliqueOrbits, to only branch on the first vertex
+     * of each orbit, see branchOnOrbits. Empty to branch on all of them.
+     */
+    template <typename Adjacency, typename Ties, typename Accuracy>
+    auto runCliqueSearch(Ties& ties, Accuracy& accuracy, size_t threadCount = 1,
+                         const std::vector<size_t>& order = {},
+                         const std::vector<size_t>& orbits = {}) const
         -> void;
 
+    /**
+     * @brief Colour refinement rounds cliqueOrbits may spend looking for
+     * automorphisms
+     *
+     * A round is about linear in the edges, so a few hundred are still cheap
+     * next to a clique search that's worth breaking symmetry in
+     */
+    static constexpr size_t SYMMETRY_SEARCH_ROUNDS = 256;
+
+    /**
+     * @brief Vertex orbits of the clique adjacency, see clique::vertexOrbits
+     *
+     * @tparam Adjacency see cliqueAdjacency
+     *
+     * @return the orbit of each vertex, as its smallest vertex
+     */
+    template <typename Adjacency>
+    [[nodiscard]] auto cliqueOrbits() const -> std::vector<size_t>;
+
+    /**
+     * @brief The root of maxCliqueHelper, minus symmetric branches
+     *
+     * If an automorphism takes u to some v that came before it, every
+     * clique through u has a copy of the same size through v, which the
+     * search has been through (or pruned) already. So only the first vertex
+     * of each orbit gets a branch at the root. The rest still show up as
+     * candidates below, it's only their own branch that's gone. Nothing in
+     * there could have beaten the best clique, so the search finds the
+     * same one as without this.\n
+     * Only good for searches after a single best clique (or any clique of
+     * some size), anything that keeps ties would lose them.
+     *
+     * @tparam Accuracy see maxCliqueHelper
+     * @tparam Ties see maxCliqueHelper
+     * @param adjacency see maxCliqueHelper
+     * @param candidateStack see maxCliqueHelper, row 0 has every vertex
+     * @param currentClique the empty clique
+     * @param ties see maxCliqueHelper
+     * @param accuracy see maxCliqueHelper
+     * @param roots which vertices get a branch
+     */
+    template <typename Accuracy, typename Ties>
+    auto branchOnOrbits(const auto& adjacency, auto& candidateStack,
+                        std::vector<size_t>& currentClique, Ties& ties,
+                        Accuracy& accuracy,
+                        const std::vector<bool>& roots) const -> void;
+
+    /**
+     * @brief Depth down to which searchCliquesInParallel turns every node
+     * into a stealable task
+     *
+     * Two levels is already about n^2 / 2 tasks, plenty to keep the threads
+     * busy, while each one is still worth the allocation
+     */
+    static constexpr size_t PARALLEL_SPLIT_DEPTH = 2;
+
+    /**
+     * @brief Exact clique search on several threads
+     *
+     * Nodes above PARALLEL_SPLIT_DEPTH are tasks in a WorkStealingPool,
+     * everything below runs maxCliqueHelper on whichever thread took the
+     * task. All threads record into one clique::SharedTies, so a clique found
+     * on one thread prunes on all of them.\n
+     * With ties kept the result is the same as a sequential search's
+     * (it gets sorted at the end, or by whoever runs the race if accuracy is
+     * a clique::Race), otherwise it's *a* maximum clique, not necessarily
+     * the lexicographically first one.
+     *
+     * @tparam Words see bits::withFixedWords
+     * @tparam Accuracy a clique::Shareable accuracy policy
+     * @tparam Ties see maxCliqueHelper
+     * @param adjacency adjacency from cliqueAdjacency
+     * @param ties where the cliques go
+     * @param accuracy asked by every thread, once it's exhausted whatever
+     * tasks are left get dropped
+     * @param threadCount number of threads, including the calling one
+     * @param roots which vertices get a branch at the root, see
+     * branchOnOrbits. Empty for all of them.
+     */
+    template <size_t Words, typename Accuracy, typename Ties>
+    auto searchCliquesInParallel(
+        const bits::BitRows<Words, Words * bits::WORD_BITS>& adjacency,
+        Ties& ties, Accuracy& accuracy, size_t threadCount,
+        const std::vector<bool>& roots = {}) const -> void;
+
     /**
      * @brief Checks the number of connections in a clique. Used for
      * finding max induced subgraph.
@@ -225,35 +968,438 @@ class Graph {
      * @param rhs is the graph with which the modular
      * product should be applied
      *
+     * @warning throws <a
+     * href="https://en.cppreference.com/w/cpp/error/invalid_argument">invalid_argument</a>
+     * if either graph has a negative edge weight
+     *
      * @return The modular product of the graphs
      */
 
     [[nodiscard]] auto modularProduct(const Graph& rhs) -> Graph;
 
     /**
-     * @brief Finds the maximum clique of the graph using Bron-Kerbosch
-     * algorithm.
+     * @brief What maxClique would do with the same arguments, without doing
+     * it
+     *
+     * The statistics are all cheap (see clique::measureStatistics), but
+     * settling AlgorithmAccuracy::AUTO takes an estimate
+     *
+     * @param accuracy see maxClique
+     * @param threadCount see maxClique
+     * @param engine see maxClique
+     *
+     * @return the plan, see planCliqueSearch for how it's made
+     */
+    [[nodiscard]] auto planMaxClique(
+        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO) const
+        -> SearchPlan;
+
+    /**
+     * @brief What maxSubgraph would do with the same arguments, without
+     * doing it
+     *
+     * The statistics are the modular product's, which does get built.
+     * Single threaded exact searches go through clique::heaviestMaxClique
+     * on the product's weights, everything else keeps all the maximum
+     * cliques for the tie-break.
+     *
+     * @param rhs see maxSubgraph
+     * @param accuracy see maxSubgraph
+     * @param threadCount see maxSubgraph
+     * @param engine see maxSubgraph
+     *
+     * @return the plan
+     */
+    [[nodiscard]] auto planMaxSubgraph(
+        const Graph& rhs, AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO)
+        -> SearchPlan;
+
+    /**
+     * @brief What operator== does with this graph and another one
+     *
+     * Nothing at all if the sizes differ, otherwise colour refinement and
+     * then backtracking inside the colour classes, on fixed width bit rows
+     * if they fit
+     *
+     * @param rhs the other graph
+     *
+     * @return the plan, with this graph's statistics (of the undirected
+     * support)
+     */
+    [[nodiscard]] auto planIsomorphism(const Graph& rhs) const -> SearchPlan;
+
+    /**
+     * @brief Guesses how long the exact maxClique would take, without
+     * running it
+     *
+     * Knuth style random probing of the branch and bound tree, see
+     * clique::estimateTreeSize. Takes a fraction of a second, and is usually
+     * within an order of magnitude, which is plenty for telling whether
+     * it's worth waiting for.
+     *
+     * @return expected node count and single threaded run time
+     */
+    [[nodiscard]] auto estimateMaxClique() const -> clique::TreeEstimate;
+
+    /**
+     * @brief How long an exact search may take for AlgorithmAccuracy::AUTO
+     * to go with it, going by estimateMaxClique
+     *
+     * @param budget the longest acceptable estimate. Copies of the graph
+     * and the modular products maxSubgraph makes keep it.
+     */
+    auto setExactBudget(std::chrono::nanoseconds budget) -> void {
+        exactBudget = budget;
+    }
+
+    /**
+     * @brief See setExactBudget
+     *
+     * @return the budget, DEFAULT_EXACT_BUDGET unless it was set
+     */
+    [[nodiscard]] auto getExactBudget() const -> std::chrono::nanoseconds {
+        return exactBudget;
+    }
+
+    /**
+     * @brief Finds the maximum clique of the graph. The exact search is
+     * planned (see planMaxClique) and runs a coloring branch and bound,
+     * a Russian doll search or a maximum independent set search on the
+     * complement.
+     *
+     * Only one clique is kept during the search, see allMaxCliques for
+     * getting all of them
      *
      * @param accuracy decides whether to use a simple approximation instead
+     * (a seeded local search, see clique::localSearch), or lets AUTO decide
+     * @param threadCount threads for the exact search, the parallel one
+     * returns *a* maximum clique, not necessarily the one a single thread finds
+     * @param engine which exact search to run, AUTO leaves it to
+     * planMaxClique. The single threaded branch and bound gives the
+     * lexicographically first maximum clique, the others just give one.
+     * So does AUTO whenever the planner goes for RUSSIAN_DOLL (very sparse
+     * graphs, one thread) or COMPLEMENT (nearly complete ones): same size,
+     * but not necessarily the same clique as BRANCH_AND_BOUND. Ask for that
+     * to always get the lexicographically first one.
      *
      * @return Vector of vertices that form the maximum clique.
      */
     [[nodiscard]] auto maxClique(
-        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT) const
+        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO) const
         -> std::vector<size_t>;
 
+    /**
+     * @brief maxClique, warm started
+     *
+     * The hint's clique is the incumbent from the first node on, so
+     * re-solving after a small edit prunes as if the search had already
+     * found it. The hint's order replaces the vertex order of the branch and
+     * bound, and of the portfolio's first entrant. Either can change which
+     * maximum clique comes back, not its size.
+     *
+     * @param hint where to start from
+     * @param accuracy see maxClique, the approximation never does worse
+     * than the hint
+     * @param threadCount see maxClique
+     * @param engine see maxClique
+     * @param onPlan called with the plan before the search starts, the
+     * same one planMaxClique would make (but for the hint's order), so
+     * there's no need to plan twice to explain it
+     *
+     * @throws std::invalid_argument if the hint's clique has vertices out
+     * of range, repeats or non-adjacent pairs, or its order isn't a
+     * permutation of the vertices
+     *
+     * @return Vector of vertices that form the maximum clique, sorted
+     */
+    [[nodiscard]] auto maxClique(
+        const CliqueHint& hint,
+        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO,
+        const std::function<void(const SearchPlan&)>& onPlan = {}) const
+        -> std::vector<size_t>;
+
+    /**
+     * @brief Exact maxClique, with a proof that nothing's bigger
+     *
+     * Whichever engine finds the clique, the proof comes from
+     * clique::certifyClique afterwards, since only the branch and bound has
+     * colorings to show for itself. Hand it to verifyMaxClique anywhere
+     * else, that's much cheaper than searching again.
+     *
+     * @param threadCount see maxClique
+     * @param engine see maxClique
+     *
+     * @return the clique, and the proof
+     */
+    [[nodiscard]] auto certifiedMaxClique(
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO) const
+        -> clique::CliqueCertificate;
+
+    /**
+     * @brief Checks a certificate from certifiedMaxClique against this
+     * graph, see clique::verifyCertificate
+     *
+     * @param certificate the certificate
+     *
+     * @return `true` iff it proves its clique is a maximum clique here
+     */
+    [[nodiscard]] auto verifyMaxClique(
+        const clique::CliqueCertificate& certificate) const -> bool;
+
+    /**
+     * @brief Exact maxClique that saves its state, and can be resumed
+     *
+     * See checkpointedCliques. Runs on one thread, and gives the same
+     * clique as the branch and bound, however many times it got resumed.
+     *
+     * @param checkpoint where to save to and resume from
+     *
+     * @throws std::invalid_argument for a state that can't be resumed here
+     * @throws std::runtime_error if the state can't be saved
+     *
+     * @return Vector of vertices that form the maximum clique, sorted
+     */
+    [[nodiscard]] auto maxClique(const SearchCheckpoint& checkpoint) const
+        -> std::vector<size_t>;
+
+    /**
+     * @brief Max clique search that can be stopped at any time
+     *
+     * Same search as the exact maxClique, except it gives up once the
+     * budget runs out and hands back the best clique it had by then.
+     * The search goes from the lexicographically first branches on, so
+     * what it finds early is biased towards low numbered vertices
+     *
+     * @param budget time and/or node limit
+     * @param onImprovement called (on this thread) with every clique that's
+     * bigger than all the ones before it, so callers can use them before the
+     * search ends. Can be empty.
+     * @param hint see the warm started maxClique, its clique isn't reported
+     * as an improvement
+     *
+     * @throws std::invalid_argument for a bad hint, see maxClique
+     *
+     * @return the best clique, and whether it's known to be maximum
+     */
+    [[nodiscard]] auto anytimeMaxClique(
+        const SearchBudget& budget,
+        const std::function<void(const std::vector<size_t>&)>& onImprovement =
+            {},
+        const CliqueHint& hint = {}) const -> AnytimeClique;
+
+    /**
+     * @brief Looks for a clique of (at least) the given size
+     *
+     * The decision version of maxClique: the search starts as if a clique
+     * of size - 1 was already known, so everything that can't get to size
+     * is pruned right away, and it stops at the first witness. Saying no
+     * is often way faster than finding the maximum.
+     *
+     * @param size vertices the clique needs
+     * @param threadCount threads for the search
+     *
+     * @return A sorted clique of exactly `size` vertices (the
+     * lexicographically first one when single threaded), or nothing if the
+     * max clique is smaller
+     */
+    [[nodiscard]] auto findCliqueOfSize(size_t size,
+                                        size_t threadCount = 1) const
+        -> std::optional<std::vector<size_t>>;
+
+    /**
+     * @brief Whether there's a clique of at least the given size
+     *
+     * @param size vertices the clique needs
+     * @param threadCount threads for the search
+     *
+     * @return `true` iff findCliqueOfSize finds something
+     */
+    [[nodiscard]] auto hasCliqueOfSize(size_t size,
+                                       size_t threadCount = 1) const -> bool;
+
+    /**
+     * @brief Finds the k biggest maximal cliques
+     *
+     * Memory stays at k cliques however many ties there are, and the search
+     * prunes against the k-th best size, so it's barely slower than
+     * maxClique for small k
+     *
+     * @param count how many cliques to find
+     * @param threadCount threads for the search. With more than one, which
+     * of several same sized cliques make the cut at the end can vary
+     *
+     * @return Up to `count` distinct maximal cliques, each one sorted,
+     * biggest first and then in lexicographic order
+     */
+    [[nodiscard]] auto topKCliques(size_t count, size_t threadCount = 1) const
+        -> std::vector<std::vector<size_t>>;
+
+    /**
+     * @brief Finds every maximum clique of the graph, not just one
+     *
+     * maxClique only keeps a single incumbent, this keeps all of them,
+     * which can get exponentially big on graphs with lots of ties
+     *
+     * @param accuracy decides whether to use a simple approximation instead
+     * (then these are just the biggest cliques it happened to find)
+     * @param threadCount threads for the exact search, doesn't change the
+     * result
+     *
+     * @return All maximum cliques, each one sorted, in lexicographic order
+     */
+    [[nodiscard]] auto allMaxCliques(
+        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1) const
+        -> std::vector<std::vector<size_t>>;
+
+    /**
+     * @brief Lazily lists every maximal clique of the graph
+     *
+     * Bron-Kerbosch without pivoting, so the cliques come out one at a time
+     * and in lexicographic order, and none of them are kept. Memory is two
+     * (n + 1) x n bit matrices made up front, candidates and excluded
+     * vertices for every depth, so O(n^2) bits however many cliques there
+     * are. Stop iterating whenever, the rest never gets searched.\n
+     * The generator reads this graph as it goes, so it can't outlive it
+     *
+     * @return Every maximal clique, each one sorted, in lexicographic order
+     */
+    [[nodiscard]] auto maximalCliques() const
+        -> Generator<std::vector<size_t>>;
+
+    /**
+     * @brief Streams every maximal clique, for when there's way too many to
+     * keep
+     *
+     * Much faster than maximalCliques on big graphs (pivoting, and
+     * degeneracy ordered subproblems, see clique::enumerateMaximalCliques),
+     * but the order's arbitrary and it can't be paused
+     *
+     * @param visit called with every maximal clique once, in no particular
+     * vertex order. The span is only valid during the call.
+     *
+     * @return How many maximal cliques there were
+     */
+    auto forEachMaximalClique(
+        const std::function<void(std::span<const size_t>)>& visit) const
+        -> size_t;
+
+    /**
+     * @brief Counts the cliques of every size up to maxSize, and how many
+     * each vertex is in
+     *
+     * Cliques don't have to be maximal. It's clique::countCliques on
+     * adjacency lists, so it's meant for the sparse end, where listing
+     * them with cliquesOfSize would take ages.
+     *
+     * @param maxSize biggest cliques to count
+     * @param threadCount threads to count on, doesn't change the result
+     *
+     * @return maxSize + 1 entries, entry k for the cliques with k vertices
+     */
+    [[nodiscard]] auto countCliques(size_t maxSize,
+                                    size_t threadCount = 1) const
+        -> std::vector<clique::CliqueCounts>;
+
+    /**
+     * @brief Counts triangles, and each vertex's local clustering
+     * coefficient
+     *
+     * Same edges as the clique searches, so only mutual ones count. It's
+     * clique::countTriangles, with bitset rows instead of three nested
+     * loops over the matrix.
+     *
+     * @param threadCount threads to count on, doesn't change the result
+     *
+     * @return the counts
+     */
+    [[nodiscard]] auto countTriangles(size_t threadCount = 1) const
+        -> clique::TriangleCounts;
+
+    /**
+     * @brief Lazily lists every clique with exactly `size` vertices
+     *
+     * Cliques don't have to be maximal. Branches that can't reach `size`
+     * anymore are skipped.\n
+     * The generator reads this graph as it goes, so it can't outlive it
+     *
+     * @param size vertices per clique, 0 gives just the empty one
+     *
+     * @return Every clique of that size, each one sorted, in lexicographic
+     * order
+     */
+    [[nodiscard]] auto cliquesOfSize(size_t size) const
+        -> Generator<std::vector<size_t>>;
+
+    /**
+     * @brief Finds a biggest set of vertices with no edges between them
+     *
+     * An edge in either direction counts, self-loops don't. It's
+     * clique::maximumIndependentSet on adjacency lists, so unlike the clique
+     * searches it's at home on big sparse graphs.
+     *
+     * @return A maximum independent set, sorted
+     */
+    [[nodiscard]] auto maximumIndependentSet() const -> std::vector<size_t>;
+
+    /**
+     * @brief Finds a smallest set of vertices touching every edge
+     *
+     * Edges and loops count the same as for maximumIndependentSet, whose
+     * sets are exactly what a minimum cover leaves out. It's
+     * clique::minimumVertexCover, exponential in the cover size rather than
+     * the vertex count, so it's the one for graphs with a small cover.
+     *
+     * @return A minimum vertex cover, sorted
+     */
+    [[nodiscard]] auto minimumVertexCover() const -> std::vector<size_t>;
+
     /**
      * @brief modidfied max clique algorithm for finding maximum induced
      * subgraphs.
      *
+     * An edge either way makes two vertices adjacent, and ties on size go
+     * to the clique with more connections (see totalConnections), then
+     * more edges (see edgeCount), then the lexicographically first.\n
+     * The exact search on one thread is clique::heaviestMaxClique, which
+     * breaks the ties as it goes. With more threads, or PORTFOLIO, every
+     * maximum clique gets collected and the tie-break is done on those.
+     *
      * @param accuracy decides whether to use a simple approximation instead
+     * @param threadCount threads for the exact search, doesn't change the
+     * result
+     * @param engine BRANCH_AND_BOUND or PORTFOLIO, anything else is
+     * BRANCH_AND_BOUND. Doesn't change the result either.
      *
      * @return Vector of vertices that form the maximum clique.
      */
     [[nodiscard]] auto modifiedMaxClique(
-        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT) const
+        AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO) const
         -> std::vector<size_t>;
 
+    /**
+     * @brief Exact modifiedMaxClique that saves its state, and can be
+     * resumed
+     *
+     * checkpointedCliques with a clique::HeaviestTies, so the state holds
+     * one clique, the best on the whole tie-break so far, and the answer is
+     * the same as clique::heaviestMaxClique's. Runs on one thread.
+     *
+     * @param checkpoint where to save to and resume from
+     *
+     * @throws std::invalid_argument for a state that can't be resumed here
+     * @throws std::runtime_error if the state can't be saved
+     *
+     * @return Vector of vertices that form the maximum clique.
+     */
+    [[nodiscard]] auto modifiedMaxClique(
+        const SearchCheckpoint& checkpoint) const -> std::vector<size_t>;
+
     /**
      * @brief Returns maximum induced subgraph of two graphs
      *
@@ -261,11 +1407,33 @@ class Graph {
      * induced subgrraph should be applied
      * @param accuracy decides whether to just use a simple approximation
      * instead
+     * @param threadCount threads for the exact clique search
+     * @param engine see modifiedMaxClique
+     * @param onPlan called with the plan before the search starts, the
+     * same one planMaxSubgraph would make, without building the modular
+     * product twice
      *
      * @return The maximum induced subgraph of the graphs
      */
     [[nodiscard]] auto maxSubgraph(
-        const Graph& rhs, AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT)
+        const Graph& rhs, AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT,
+        size_t threadCount = 1, CliqueEngine engine = CliqueEngine::AUTO,
+        const std::function<void(const SearchPlan&)>& onPlan = {}) -> Graph;
+
+    /**
+     * @brief Exact maxSubgraph that saves its state, and can be resumed
+     *
+     * @param rhs the other graph
+     * @param checkpoint see the checkpointed modifiedMaxClique, which runs on
+     * the modular product
+     *
+     * @throws std::invalid_argument for a state that can't be resumed here
+     * @throws std::runtime_error if the state can't be saved
+     *
+     * @return The maximum induced subgraph of the graphs
+     */
+    [[nodiscard]] auto maxSubgraph(const Graph& rhs,
+                                   const SearchCheckpoint& checkpoint)
         -> Graph;
 
     /**
@@ -273,11 +1441,14 @@ class Graph {
      *
      * @param accuracy Determines whether to return the approximation or exact
      * solution.
+     * @param threadCount see maxClique
+     * @param engine see maxClique
      *
      * @return Vector of vertices that form the maximum clique.
      */
-    [[nodiscard]] auto maxCliqueGraph(AlgorithmAccuracy accuracy) const
-        -> Graph;
+    [[nodiscard]] auto maxCliqueGraph(
+        AlgorithmAccuracy accuracy, size_t threadCount = 1,
+        CliqueEngine engine = CliqueEngine::AUTO) const -> Graph;
 
     /**
      * @brief Gives the induced subgraph given by the vertices.
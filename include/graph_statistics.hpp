@@ -0,0 +1,69 @@
+/**
+ * @file graph_statistics.hpp
+ * @brief Cheap numbers about a graph, for picking how to search it
+ */
+#pragma once
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief What measureStatistics found out
+ */
+struct GraphStatistics {
+    /**
+     * @brief Vertices
+     */
+    size_t vertexCount;
+
+    /**
+     * @brief Undirected edges, each pair counted once
+     */
+    size_t edgeCount;
+
+    /**
+     * @brief Edges over vertex pairs, 0 for graphs with fewer than 2 vertices
+     */
+    double density;
+
+    /**
+     * @brief Same for the complement, 1 - density when there are any pairs
+     */
+    double complementDensity;
+
+    /**
+     * @brief Biggest degree
+     */
+    size_t maxDegree;
+
+    /**
+     * @brief Smallest k such that every subgraph has a vertex of degree at
+     * most k. No clique has more than k + 1 vertices.
+     */
+    size_t degeneracy;
+
+    /**
+     * @brief Whether some vertex was proven to be in a bigger orbit than
+     * itself, see vertexOrbits
+     */
+    bool symmetric;
+};
+
+/**
+ * @brief Measures a graph
+ *
+ * Everything but the symmetry is linear in the adjacency bits, the
+ * degeneracy comes from degeneracyOrder. The symmetry flag is the same
+ * bounded orbit search the branch and bound breaks symmetry with, so a
+ * graph with symmetries too well hidden for it counts as not symmetric.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param symmetryRounds refinement rounds vertexOrbits may use, 0 skips it
+ *
+ * @return the statistics
+ */
+[[nodiscard]] auto measureStatistics(const bits::BitMatrix& adjacency,
+                                     size_t symmetryRounds) -> GraphStatistics;
+
+}  // namespace clique
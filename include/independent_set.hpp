@@ -0,0 +1,55 @@
+/**
+ * @file independent_set.hpp
+ * @brief Maximum independent set by branch-and-reduce, for sparse graphs
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "clique_policies.hpp"
+
+namespace clique {
+
+/**
+ * @brief Finds a biggest set of pairwise non-adjacent vertices
+ *
+ * Branch-and-reduce on adjacency lists, so memory is linear in the edges
+ * and big sparse graphs are fine. Before every branch, these get applied
+ * until none of them changes anything:
+ * - degree 0 and 1: the vertex goes in
+ * - degree 2: in a triangle the vertex goes in, otherwise it's folded
+ * together with its neighbours into one vertex
+ * - domination: if N[u] is inside N[v] for a neighbour u, v can go
+ * - twins: two degree 3 vertices with the same neighbours go in together,
+ * or get folded with those neighbours
+ * - LP (Nemhauser & Trotter): the LP relaxation, solved as a bipartite
+ * matching, settles every vertex it gives an integral value
+ *
+ * Then it branches on a vertex of maximum degree, in or out along with its
+ * mirrors, pruning with the smaller of the LP bound and a greedy clique
+ * cover. Whenever the graph falls apart into components, or shrinks to half
+ * its size, what's left gets renumbered and solved on its own.
+ *
+ * @param neighbours adjacency lists of a simple undirected graph, every
+ * edge in both lists, no loops or repeats
+ *
+ * @return a maximum independent set, sorted
+ */
+[[nodiscard]] auto maximumIndependentSet(
+    const std::vector<std::vector<size_t>>& neighbours) -> std::vector<size_t>;
+
+/**
+ * @brief maximumIndependentSet as one entrant of a race
+ *
+ * For racing clique searches on the complement: the sets it finds are
+ * recorded as cliques, and it prunes against the biggest clique anyone in
+ * the race found. Gives up as soon as the race is over.
+ *
+ * @param neighbours same as for maximumIndependentSet
+ * @param race where the best set goes, the caller finishes it
+ */
+auto maximumIndependentSet(const std::vector<std::vector<size_t>>& neighbours,
+                           Race<IgnoreTies>& race) -> void;
+
+}  // namespace clique
@@ -0,0 +1,63 @@
+/**
+ * @file local_search.hpp
+ * @brief Penalty based local search for big cliques, in the style of DLS-MC
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <span>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief Knobs for localSearch
+ */
+struct LocalSearchSettings {
+    /**
+     * @brief Vertex selections (adds, swaps and restarts) allowed in total
+     */
+    size_t maxSteps;
+
+    /**
+     * @brief Seed for the tie breaking, same seed means same run
+     */
+    std::uint64_t seed;
+
+    /**
+     * @brief How many penalty updates go by between penalty decreases
+     *
+     * 1 (or 0) means penalties never stick (and perturbations restart from
+     * a random vertex), bigger values push the search harder towards
+     * vertices it hasn't been using
+     */
+    size_t penaltyDelay = 2;
+};
+
+/**
+ * @brief Looks for big cliques by walking between maximal ones
+ *
+ * Dynamic local search (Pullan & Hoos' DLS-MC): greedily add vertices
+ * adjacent to the whole clique, then swap in vertices that miss exactly one
+ * member (plateau moves) until that runs dry, then penalise the clique's
+ * vertices and restart from a small piece of it (or, every few rounds,
+ * from a random vertex, so it can't get stuck in one corner of the graph).\n
+ * Picks are by lowest penalty, with ties broken by a std::mt19937_64,
+ * so a run only depends on the graph and the seed.\n
+ * No guarantees on what it finds, but it doesn't care about vertex
+ * numbering the way a truncated exhaustive search does.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param settings step budget, seed and penalty delay
+ * @param visit called with every maximal clique the search passes through
+ * (repeats included), in no particular vertex order. The span is only valid
+ * during the call.
+ */
+auto localSearch(const bits::BitMatrix& adjacency,
+                 const LocalSearchSettings& settings,
+                 const std::function<void(std::span<const size_t>)>& visit)
+    -> void;
+
+}  // namespace clique
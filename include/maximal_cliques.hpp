@@ -0,0 +1,137 @@
+/**
+ * @file maximal_cliques.hpp
+ * @brief Streaming maximal clique enumeration, for when there's millions
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief Upper bound on the biggest clique among some candidates
+ *
+ * Greedy sequential coloring of the candidates. Every color class is an
+ * independent set, so a clique can't use more than one vertex of each,
+ * which makes the number of colors an upper bound on what's left to add.
+ *
+ * @param adjacency adjacency rows, any kind the bits functions take
+ * @param candidates the vertices to color
+ * @param uncolored scratch row, as wide as candidates
+ * @param colorClass another scratch row, as wide as candidates
+ *
+ * @return the number of colors used
+ */
+auto coloringBound(const auto& adjacency, const auto& candidates,
+                   auto&& uncolored, auto&& colorClass) -> size_t {
+    std::ranges::copy(candidates, uncolored.begin());
+    size_t colors = 0;
+
+    while (!bits::none(uncolored)) {
+        ++colors;
+        std::ranges::copy(uncolored, colorClass.begin());
+        for (size_t vertex = bits::nextSet(colorClass, 0);
+             vertex < colorClass.size() * bits::WORD_BITS;
+             vertex = bits::nextSet(colorClass, vertex + 1)) {
+            bits::reset(uncolored, vertex);
+            bits::andNot(colorClass, adjacency[vertex], colorClass);
+        }
+    }
+
+    return colors;
+}
+
+/**
+ * @brief Whether no clique in a branch of the search can be maximal
+ *
+ * The same cut as maximalCliques' dominated excluded vertex: one that's
+ * adjacent to the whole clique and to every candidate, without being a
+ * candidate itself, extends every clique the branch can reach. Here the
+ * excluded vertices are worked out from the clique instead of tracked.
+ *
+ * @param adjacency loopless adjacency rows, any kind the bits functions take
+ * @param clique the branch's clique so far
+ * @param candidates the vertices that can still extend it
+ * @param common scratch row, as wide as candidates
+ *
+ * @return `true` iff some vertex extends every clique in the branch,
+ * `false` for the empty clique, which has no excluded vertices to check
+ */
+auto isDominatedBranch(const auto& adjacency, std::span<const size_t> clique,
+                       const auto& candidates, auto&& common) -> bool {
+    if (clique.empty()) {
+        return false;
+    }
+
+    // Rows are loopless, so the clique's own members drop out
+    std::ranges::copy(adjacency[clique.front()], common.begin());
+    for (size_t member : clique.subspan(1)) {
+        bits::intersect(common, adjacency[member], common);
+    }
+    bits::andNot(common, candidates, common);
+
+    size_t candidateCount = bits::count(candidates);
+    for (size_t vertex = bits::nextSet(common, 0);
+         vertex < common.size() * bits::WORD_BITS;
+         vertex = bits::nextSet(common, vertex + 1)) {
+        if (bits::intersectCount(candidates, adjacency[vertex]) ==
+            candidateCount) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Orders vertices so each one has few neighbours after it
+ *
+ * Smallest-last order (Matula & Beck, bucketed like Batagelj & Zaversnik):
+ * keep taking out a vertex of minimum degree among the ones left.
+ * Every vertex then has at most degeneracy-many neighbours later on.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ *
+ * @return every vertex, in degeneracy order
+ */
+[[nodiscard]] auto degeneracyOrder(const bits::BitMatrix& adjacency)
+    -> std::vector<size_t>;
+
+/**
+ * @brief degeneracyOrder on adjacency lists, for graphs too big for a
+ * BitMatrix
+ *
+ * @param neighbours adjacency lists of a simple undirected graph, every
+ * edge in both lists, no loops or repeats
+ *
+ * @return every vertex, in degeneracy order
+ */
+[[nodiscard]] auto degeneracyOrder(
+    const std::vector<std::vector<size_t>>& neighbours) -> std::vector<size_t>;
+
+/**
+ * @brief Lists every maximal clique, without ever holding more than one
+ *
+ * Eppstein, Löffler & Strash: the outer loop goes through the vertices in
+ * degeneracy order, and each one only starts cliques with its later
+ * neighbours, so every subproblem is as small as its neighbourhood.
+ * Inside, it's Bron-Kerbosch with Tomita's pivot (the vertex covering the
+ * most candidates), on bitsets local to that neighbourhood.\n
+ * Memory is quadratic in the biggest degree, however many cliques there are.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param visit called with every maximal clique exactly once, in no
+ * particular vertex order. The span is only valid during the call.
+ * A graph without vertices has just the empty clique.
+ *
+ * @return how many maximal cliques there were
+ */
+auto enumerateMaximalCliques(
+    const bits::BitMatrix& adjacency,
+    const std::function<void(std::span<const size_t>)>& visit) -> size_t;
+
+}  // namespace clique
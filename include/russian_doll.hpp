@@ -0,0 +1,51 @@
+/**
+ * @file russian_doll.hpp
+ * @brief Russian doll search for maximum cliques
+ */
+#pragma once
+
+#include <vector>
+
+#include "bitset.hpp"
+#include "clique_policies.hpp"
+
+namespace clique {
+
+/**
+ * @brief Finds a maximum clique by solving every suffix of an ordering
+ *
+ * Östergård's algorithm, the one in Cliquer: with the vertices in some
+ * order, doll i is the subgraph of vertex i and everything after it. The
+ * dolls get solved from the smallest (just the last vertex) outwards, each
+ * one only looking for cliques that start at its first vertex, and each
+ * one is at most one bigger than the doll inside it. That's also a bound:
+ * once the search is down to candidates from doll j on, the clique can't
+ * grow by more than what doll j holds.\n
+ * The order is smallest-last (see degeneracyOrder), so the innermost dolls
+ * are the dense core. There's no coloring, so a node is much cheaper than
+ * in the branch and bound, which pays off on sparse, spread out graphs where
+ * the coloring doesn't prune much anyway. On dense graphs it's the other way
+ * around.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ *
+ * @return a maximum clique, sorted
+ */
+[[nodiscard]] auto russianDollSearch(const bits::BitMatrix& adjacency)
+    -> std::vector<size_t>;
+
+/**
+ * @brief Russian doll search as one entrant of a race
+ *
+ * Prunes against the best clique anyone in the race found and records its
+ * own improvements there. A doll pruned against someone else's clique gets
+ * that clique's size as its bound, which is still an upper bound on it.
+ * Gives up as soon as the race is over.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param race where the best clique goes, the caller finishes it
+ */
+auto russianDollSearch(const bits::BitMatrix& adjacency,
+                       Race<IgnoreTies>& race) -> void;
+
+}  // namespace clique
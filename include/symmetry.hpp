@@ -0,0 +1,39 @@
+/**
+ * @file symmetry.hpp
+ * @brief Vertex orbits, for skipping symmetric copies in the clique search
+ */
+#pragma once
+
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief Splits the vertices into orbits of the graph's automorphism group,
+ * as far as a bounded search can prove
+ *
+ * Colour refinement first, which puts vertices that might be symmetric in
+ * the same colour class. Random graphs usually come out with every vertex
+ * on its own there, and that's the end of it. Otherwise, for each vertex
+ * and each earlier orbit in its class, an individualization-refinement
+ * search (the same idea as nauty's, minus the pruning) looks for an
+ * automorphism mapping one onto the other. Every automorphism found merges
+ * all of its cycles at once, so a vertex transitive graph is done after a
+ * handful of them.\n
+ * Only automorphisms that were checked edge by edge count. Once the round
+ * budget runs out the rest stay apart, which is always safe: they're just
+ * searched like any other vertex.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param roundLimit refinement rounds allowed in total, the first
+ * refinement's included
+ *
+ * @return for each vertex, the smallest vertex it's proven to share an
+ * orbit with (itself, for a vertex on its own)
+ */
+[[nodiscard]] auto vertexOrbits(const bits::BitMatrix& adjacency,
+                                size_t roundLimit) -> std::vector<size_t>;
+
+}  // namespace clique
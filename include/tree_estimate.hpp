@@ -0,0 +1,82 @@
+/**
+ * @file tree_estimate.hpp
+ * @brief Guessing how big a clique search is going to be, before running it
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief Knobs for estimateTreeSize
+ */
+struct EstimateSettings {
+    /**
+     * @brief Random walks from the root, the estimate is their average
+     */
+    size_t probes;
+
+    /**
+     * @brief Seed for picking the children, same seed means same estimate
+     */
+    std::uint64_t seed;
+
+    /**
+     * @brief Smallest clique the search still cares about, branches that
+     * can't reach it get pruned. One more than a clique that's already
+     * known when only a better one is wanted, the known size itself when
+     * ties matter too.
+     */
+    size_t target;
+};
+
+/**
+ * @brief What estimateTreeSize came up with
+ */
+struct TreeEstimate {
+    /**
+     * @brief Expected number of expanded search tree nodes, the ones that
+     * get past the bounds and branch, same as Budget counts
+     */
+    double nodes;
+
+    /**
+     * @brief nodes, times what a node cost on average during the probes
+     */
+    std::chrono::nanoseconds time;
+
+    /**
+     * @brief Nodes the probes expanded themselves
+     */
+    size_t probedNodes;
+};
+
+/**
+ * @brief Estimates the size of the coloring bounded branch and bound tree,
+ * the one Graph::maxCliqueHelper goes through
+ *
+ * Knuth's estimator: walk down from the root, picking a child uniformly at
+ * random each time, and multiply the branching factors seen on the way.
+ * The sum of those products over the walk's depths is an unbiased estimate
+ * of the node count, and averaging a few hundred walks tames the variance
+ * well enough to tell seconds from hours.\n
+ * The pruning is the same as the real search's, against a fixed target.
+ * The real search starts from nothing and has to work its way up to it, so
+ * on a target it reaches quickly this comes out a bit low.\n
+ * Each probe costs about depth-many nodes, so this is cheap next to any
+ * search worth estimating.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param settings probe count, seed and target
+ *
+ * @return the estimate, all zero if even the root gets pruned
+ */
+[[nodiscard]] auto estimateTreeSize(const bits::BitMatrix& adjacency,
+                                    const EstimateSettings& settings)
+    -> TreeEstimate;
+
+}  // namespace clique
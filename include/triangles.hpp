@@ -0,0 +1,55 @@
+/**
+ * @file triangles.hpp
+ * @brief Triangle counts and clustering coefficients, by row intersection
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief What countTriangles found
+ */
+struct TriangleCounts {
+    /**
+     * @brief Triangles in the whole graph
+     */
+    std::uint64_t total{0};
+
+    /**
+     * @brief For each vertex, how many triangles it's in
+     */
+    std::vector<std::uint64_t> perVertex;
+
+    /**
+     * @brief For each vertex, the fraction of its neighbour pairs that are
+     * adjacent, 0 for vertices with fewer than 2 neighbours
+     */
+    std::vector<double> clustering;
+};
+
+/**
+ * @brief Counts triangles, and each vertex's local clustering coefficient
+ *
+ * A vertex's triangles are half of what its row shares with each of its
+ * neighbours' rows, so it's one intersectCount per edge end, each of them
+ * a pass of AND and popcount over two rows, and nothing ever touches the
+ * same vertex from two rows. Rows are handed out in blocks, so the threads
+ * only share the adjacency.\n
+ * For graphs too big for a BitMatrix, countCliques on adjacency lists gets
+ * the same numbers out of its size 3 entry.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ * @param threadCount threads to count on, 0 counts as 1
+ *
+ * @return the counts
+ */
+[[nodiscard]] auto countTriangles(const bits::BitMatrix& adjacency,
+                                  size_t threadCount = 1) -> TriangleCounts;
+
+}  // namespace clique
@@ -0,0 +1,35 @@
+/**
+ * @file vertex_cover.hpp
+ * @brief Minimum vertex cover by kernelisation and a bounded search tree
+ */
+#pragma once
+
+#include <vector>
+
+#include "bitset.hpp"
+
+namespace clique {
+
+/**
+ * @brief Finds a smallest set of vertices touching every edge
+ *
+ * What a cover leaves out is an independent set, so this is the same
+ * problem as maximumIndependentSet, only parameterised by the cover size.
+ * The clique searches use maximumIndependentSet for the complement route,
+ * which handles bigger covers; Graph::minimumVertexCover is the way in.\n
+ * First a crown reduction (Chen, Kanj & Jia) takes out whatever a maximal
+ * plus a bipartite matching can settle, then the cover size k goes up from
+ * a matching lower bound until the FPT search finds one. Every node of that
+ * search applies the degree 0, 1 and 2 (triangle) rules and Buss' rule
+ * (degree over k means it's in the cover, more than k^2 edges means no),
+ * then branches on a max degree vertex: either it's in, or all its
+ * neighbours are. It's O(1.47^k) or so, whatever the vertex count.
+ *
+ * @param adjacency symmetric, loopless adjacency bits, one row per vertex
+ *
+ * @return a minimum vertex cover, sorted
+ */
+[[nodiscard]] auto minimumVertexCover(const bits::BitMatrix& adjacency)
+    -> std::vector<size_t>;
+
+}  // namespace clique
@@ -0,0 +1,116 @@
+/**
+ * @file weighted_clique.hpp
+ * @brief Max clique with modifiedMaxClique's tie-break built into the search
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace clique {
+
+/**
+ * @brief Finds the best clique of a multigraph by (size, connections,
+ * edges), in that order
+ *
+ * Two vertices are adjacent if there's an edge either way. Connections
+ * count the directions that have an edge (1 or 2 per pair), edges count
+ * every edge with its multiplicity, both over the pairs of the clique.\n
+ * It's the coloring branch and bound with the whole objective as the
+ * incumbent, so it never collects ties: a branch whose coloring bound can
+ * only tie on size still has to be able to beat the best on connections
+ * or edges. That bound takes the best gains of the candidates against the
+ * clique so far, plus the most the missing vertices could add among
+ * themselves.
+ *
+ * @param multiplicities the adjacency matrix, entry [i][j] is how many
+ * edges go from i to j, the diagonal doesn't count
+ *
+ * @return the lexicographically first of the best cliques, sorted
+ */
+[[nodiscard]] auto heaviestMaxClique(
+    const std::vector<std::vector<int>>& multiplicities) -> std::vector<size_t>;
+
+/**
+ * @brief Tie policy with heaviestMaxClique's objective: one incumbent, the
+ * best by (size, connections, edges), then the lexicographically first
+ *
+ * For searches that can't break the ties as they go, like a checkpointed
+ * one. Cliques that tie on size still get explored, but only the winner is
+ * kept, along with its score, so nothing piles up however many ties there
+ * are, and the order they're found in doesn't matter.
+ */
+class HeaviestTies {
+   private:
+    /**
+     * @brief The adjacency matrix the cliques get scored on
+     */
+    const std::vector<std::vector<int>>& multiplicities;
+
+    /**
+     * @brief The best clique so far
+     */
+    std::vector<size_t> best;
+
+    /**
+     * @brief Connections in the best clique, see heaviestMaxClique
+     */
+    size_t bestConnections{0};
+
+    /**
+     * @brief Edges in the best clique, see heaviestMaxClique
+     */
+    size_t bestEdges{0};
+
+   public:
+    /**
+     * @brief Starts off with the empty clique
+     *
+     * @param multiplicities same as heaviestMaxClique's, has to outlive this
+     */
+    explicit HeaviestTies(const std::vector<std::vector<int>>& multiplicities)
+        : multiplicities{multiplicities} {}
+
+    /**
+     * @brief Whether cliques that only tie still get recorded, they can
+     * still win on connections or edges
+     */
+    static constexpr bool KEEPS_TIES = true;
+
+    /**
+     * @brief Size of the best clique so far
+     *
+     * @return the size
+     */
+    [[nodiscard]] auto bestSize() const -> size_t { return best.size(); }
+
+    /**
+     * @brief Whether a branch could still be worth recording
+     *
+     * @param reachableSize upper bound on cliques in the branch
+     *
+     * @return `true` iff it could at least tie on size
+     */
+    [[nodiscard]] auto isWorthExploring(size_t reachableSize) const -> bool {
+        return reachableSize >= bestSize();
+    }
+
+    /**
+     * @brief Offers a clique, which replaces the best if it scores higher,
+     * or the same and comes first
+     *
+     * @param clique the clique, sorted
+     */
+    auto record(const std::vector<size_t>& clique) -> void;
+
+    /**
+     * @brief The best clique found
+     *
+     * @return the clique
+     */
+    [[nodiscard]] auto getBest() const -> const std::vector<size_t>& {
+        return best;
+    }
+};
+
+}  // namespace clique
@@ -0,0 +1,179 @@
+/**
+ * @file work_stealing.hpp
+ * @brief A tiny work-stealing thread pool, for splitting up search trees
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Runs tasks on several threads, each with its own deque
+ *
+ * Workers pop from the back of their own deque (so they go depth-first on
+ * what they just pushed) and, when that's empty, steal from the front of
+ * somebody else's (which is where the big, shallow subtrees are). Workers
+ * with nothing to do sleep until something gets pushed.\n
+ * Tasks can push more tasks while they run, and everything is done once
+ * no task is queued or running anywhere
+ *
+ * @tparam Task whatever a unit of work is, must be movable
+ */
+template <typename Task>
+class WorkStealingPool {
+   private:
+    /**
+     * @brief One worker's deque
+     */
+    struct Queue {
+        /**
+         * @brief Guards tasks
+         */
+        std::mutex mutex;
+
+        /**
+         * @brief The queued tasks
+         */
+        std::deque<Task> tasks;
+    };
+
+    /**
+     * @brief One deque per worker
+     */
+    std::vector<Queue> queues;
+
+    /**
+     * @brief Tasks that were pushed and haven't finished yet
+     */
+    std::atomic<size_t> pending{0};
+
+    /**
+     * @brief Bumped whenever there's something new for idle workers to
+     * look at: a task got pushed, or the last one finished. They sleep on
+     * it instead of spinning.
+     */
+    std::atomic<size_t> epoch{0};
+
+    /**
+     * @brief Wakes up every idle worker
+     */
+    auto wake() -> void {
+        ++epoch;
+        epoch.notify_all();
+    }
+
+    /**
+     * @brief Gets the next task for a worker, stealing if it has to
+     *
+     * @param worker the worker asking
+     *
+     * @return the task, or nothing once all the work is done
+     */
+    auto next(size_t worker) -> std::optional<Task> {
+        for (;;) {
+            // Read before looking, so a push after the look still changes
+            // it, and the wait below falls right through
+            size_t seen = epoch.load();
+            {
+                Queue& own = queues[worker];
+                std::scoped_lock lock{own.mutex};
+                if (!own.tasks.empty()) {
+                    Task task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    return task;
+                }
+            }
+
+            for (size_t offset = 1; offset < queues.size(); ++offset) {
+                Queue& victim = queues[(worker + offset) % queues.size()];
+                std::scoped_lock lock{victim.mutex};
+                if (!victim.tasks.empty()) {
+                    Task task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return task;
+                }
+            }
+
+            // Someone's still running a task, which might push more
+            if (pending.load() == 0) {
+                return std::nullopt;
+            }
+            epoch.wait(seen);
+        }
+    }
+
+   public:
+    /**
+     * @brief Makes a pool with empty deques
+     *
+     * @param workerCount number of workers (and threads), at least 1
+     */
+    explicit WorkStealingPool(size_t workerCount)
+        : queues(std::max<size_t>(workerCount, 1)) {}
+
+    /**
+     * @brief Number of workers
+     *
+     * @return the worker count
+     */
+    [[nodiscard]] auto getWorkerCount() const -> size_t {
+        return queues.size();
+    }
+
+    /**
+     * @brief Queues a task on a worker's deque
+     *
+     * Safe to call from inside a running task
+     *
+     * @param worker whose deque to use, usually the caller's own
+     * @param task the task
+     */
+    auto push(size_t worker, Task task) -> void {
+        ++pending;
+        {
+            Queue& queue = queues[worker];
+            std::scoped_lock lock{queue.mutex};
+            queue.tasks.push_back(std::move(task));
+        }
+        wake();
+    }
+
+    /**
+     * @brief Runs everything that's queued (and whatever that queues)
+     *
+     * The calling thread is worker 0, the others get their own threads.\n
+     * Returns once all of them ran out of work
+     *
+     * @param makeWorker called once per worker, on its own thread, with the
+     * worker index. Should return a callable taking a `Task&&`, which can
+     * hold per-thread scratch space.
+     */
+    template <typename MakeWorker>
+    auto run(MakeWorker makeWorker) -> void {
+        auto workLoop = [&](size_t worker) {
+            auto work = makeWorker(worker);
+            while (auto task = next(worker)) {
+                work(std::move(*task));
+                if (--pending == 0) {
+                    wake();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(queues.size() - 1);
+        for (size_t worker = 1; worker < queues.size(); ++worker) {
+            threads.emplace_back(workLoop, worker);
+        }
+
+        workLoop(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+};
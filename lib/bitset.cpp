@@ -0,0 +1,260 @@
+/**
+ * @file bitset.cpp
+ * @brief Scalar, AVX2 and AVX-512 set kernels, plus picking between them
+ */
+#include "bitset.hpp"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define BITS_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+using std::span;
+
+namespace bits {
+
+namespace {
+
+auto scalarIntersect(span<const Word> lhs, span<const Word> rhs,
+                     span<Word> out) -> void {
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = lhs[i] & rhs[i];
+    }
+}
+
+auto scalarIntersectCount(span<const Word> lhs, span<const Word> rhs)
+    -> size_t {
+    size_t total = 0;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        total += static_cast<size_t>(std::popcount(lhs[i] & rhs[i]));
+    }
+
+    return total;
+}
+
+auto scalarAndNot(span<const Word> lhs, span<const Word> rhs, span<Word> out)
+    -> void {
+    for (size_t i = 0; i < out.size(); ++i) {
+        out[i] = lhs[i] & ~rhs[i];
+    }
+}
+
+auto scalarCount(span<const Word> set) -> size_t {
+    size_t total = 0;
+    for (Word word : set) {
+        total += static_cast<size_t>(std::popcount(word));
+    }
+
+    return total;
+}
+
+#ifdef BITS_X86_KERNELS
+
+constexpr size_t AVX2_WORDS = sizeof(__m256i) / sizeof(Word);
+constexpr size_t AVX512_WORDS = sizeof(__m512i) / sizeof(Word);
+
+// Nibble -> popcount table for the pshufb trick, repeated once per 128 bit
+// lane since that's how vpshufb sees the world
+constexpr auto NIBBLE_POPCOUNTS = [] {
+    constexpr size_t NIBBLES = 16;
+    std::array<char, 2 * NIBBLES> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = static_cast<char>(std::popcount(i % NIBBLES));
+    }
+    return table;
+}();
+constexpr char NIBBLE_MASK = 0x0F;
+constexpr int NIBBLE_BITS = 4;
+
+__attribute__((target("avx2"))) auto load256(const Word& first) -> __m256i {
+    __m256i vec;
+    std::memcpy(&vec, &first, sizeof(vec));
+    return vec;
+}
+
+__attribute__((target("avx2"))) auto store256(Word& first, __m256i vec)
+    -> void {
+    std::memcpy(&first, &vec, sizeof(vec));
+}
+
+// Mula's popcount: look each nibble up in a table, then sum the bytes of
+// each 64 bit lane with sad against zero
+__attribute__((target("avx2"))) auto popcount256(__m256i vec) -> __m256i {
+    __m256i table;
+    std::memcpy(&table, NIBBLE_POPCOUNTS.data(), sizeof(table));
+    const __m256i mask = _mm256_set1_epi8(NIBBLE_MASK);
+
+    __m256i low = _mm256_and_si256(vec, mask);
+    __m256i high = _mm256_and_si256(_mm256_srli_epi16(vec, NIBBLE_BITS), mask);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(table, low),
+                                    _mm256_shuffle_epi8(table, high));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+__attribute__((target("avx2"))) auto horizontalSum256(__m256i vec) -> size_t {
+    std::array<Word, AVX2_WORDS> lanes{};
+    store256(lanes[0], vec);
+    size_t total = 0;
+    for (Word lane : lanes) {
+        total += lane;
+    }
+
+    return total;
+}
+
+__attribute__((target("avx2"))) auto avx2Intersect(span<const Word> lhs,
+                                                   span<const Word> rhs,
+                                                   span<Word> out) -> void {
+    size_t i = 0;
+    for (; i + AVX2_WORDS <= out.size(); i += AVX2_WORDS) {
+        store256(out[i], _mm256_and_si256(load256(lhs[i]), load256(rhs[i])));
+    }
+    scalarIntersect(lhs.subspan(i), rhs.subspan(i), out.subspan(i));
+}
+
+__attribute__((target("avx2"))) auto avx2IntersectCount(span<const Word> lhs,
+                                                        span<const Word> rhs)
+    -> size_t {
+    __m256i sums = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + AVX2_WORDS <= lhs.size(); i += AVX2_WORDS) {
+        sums = _mm256_add_epi64(
+            sums,
+            popcount256(_mm256_and_si256(load256(lhs[i]), load256(rhs[i]))));
+    }
+
+    return horizontalSum256(sums) +
+           scalarIntersectCount(lhs.subspan(i), rhs.subspan(i));
+}
+
+__attribute__((target("avx2"))) auto avx2AndNot(span<const Word> lhs,
+                                                span<const Word> rhs,
+                                                span<Word> out) -> void {
+    size_t i = 0;
+    for (; i + AVX2_WORDS <= out.size(); i += AVX2_WORDS) {
+        // NB: andnot negates its *first* argument
+        store256(out[i],
+                 _mm256_andnot_si256(load256(rhs[i]), load256(lhs[i])));
+    }
+    scalarAndNot(lhs.subspan(i), rhs.subspan(i), out.subspan(i));
+}
+
+__attribute__((target("avx2"))) auto avx2Count(span<const Word> set)
+    -> size_t {
+    __m256i sums = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + AVX2_WORDS <= set.size(); i += AVX2_WORDS) {
+        sums = _mm256_add_epi64(sums, popcount256(load256(set[i])));
+    }
+
+    return horizontalSum256(sums) + scalarCount(set.subspan(i));
+}
+
+// The 512 bit loads/stores take void pointers, so no memcpy dance needed
+__attribute__((target("avx512f"))) auto avx512Intersect(span<const Word> lhs,
+                                                        span<const Word> rhs,
+                                                        span<Word> out)
+    -> void {
+    size_t i = 0;
+    for (; i + AVX512_WORDS <= out.size(); i += AVX512_WORDS) {
+        _mm512_storeu_si512(&out[i],
+                            _mm512_and_si512(_mm512_loadu_si512(&lhs[i]),
+                                             _mm512_loadu_si512(&rhs[i])));
+    }
+    avx2Intersect(lhs.subspan(i), rhs.subspan(i), out.subspan(i));
+}
+
+__attribute__((target("avx512f"))) auto avx512AndNot(span<const Word> lhs,
+                                                     span<const Word> rhs,
+                                                     span<Word> out) -> void {
+    size_t i = 0;
+    for (; i + AVX512_WORDS <= out.size(); i += AVX512_WORDS) {
+        _mm512_storeu_si512(&out[i],
+                            _mm512_andnot_si512(_mm512_loadu_si512(&rhs[i]),
+                                                _mm512_loadu_si512(&lhs[i])));
+    }
+    avx2AndNot(lhs.subspan(i), rhs.subspan(i), out.subspan(i));
+}
+
+// Plain AVX-512F has no popcount, that needs the VPOPCNTDQ extension
+__attribute__((target("avx512f,avx512vpopcntdq"))) auto avx512IntersectCount(
+    span<const Word> lhs, span<const Word> rhs) -> size_t {
+    __m512i sums = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + AVX512_WORDS <= lhs.size(); i += AVX512_WORDS) {
+        sums = _mm512_add_epi64(
+            sums, _mm512_popcnt_epi64(_mm512_and_si512(
+                      _mm512_loadu_si512(&lhs[i]), _mm512_loadu_si512(&rhs[i]))));
+    }
+
+    return static_cast<size_t>(_mm512_reduce_add_epi64(sums)) +
+           avx2IntersectCount(lhs.subspan(i), rhs.subspan(i));
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq"))) auto avx512Count(
+    span<const Word> set) -> size_t {
+    __m512i sums = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + AVX512_WORDS <= set.size(); i += AVX512_WORDS) {
+        sums = _mm512_add_epi64(
+            sums, _mm512_popcnt_epi64(_mm512_loadu_si512(&set[i])));
+    }
+
+    return static_cast<size_t>(_mm512_reduce_add_epi64(sums)) +
+           avx2Count(set.subspan(i));
+}
+
+#endif
+
+constexpr Kernels SCALAR_KERNELS{KernelLevel::SCALAR, scalarIntersect,
+                                 scalarIntersectCount, scalarAndNot,
+                                 scalarCount};
+
+auto detectKernels() -> std::vector<Kernels> {
+    std::vector<Kernels> found{SCALAR_KERNELS};
+
+#ifdef BITS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") == 0) {
+        return found;
+    }
+    found.push_back(Kernels{KernelLevel::AVX2, avx2Intersect,
+                            avx2IntersectCount, avx2AndNot, avx2Count});
+
+    if (__builtin_cpu_supports("avx512f") == 0) {
+        return found;
+    }
+    bool hasPopcount = __builtin_cpu_supports("avx512vpopcntdq") != 0;
+    found.push_back(Kernels{
+        KernelLevel::AVX512, avx512Intersect,
+        hasPopcount ? avx512IntersectCount : avx2IntersectCount, avx512AndNot,
+        hasPopcount ? avx512Count : avx2Count});
+#endif
+
+    return found;
+}
+
+}  // namespace
+
+auto kernels() -> const Kernels& {
+    static const Kernels best = detectKernels().back();
+    return best;
+}
+
+auto availableKernels() -> std::vector<Kernels> { return detectKernels(); }
+
+auto kernelLevelName(KernelLevel level) -> const char* {
+    switch (level) {
+        case KernelLevel::AVX2:
+            return "avx2";
+        case KernelLevel::AVX512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+}  // namespace bits
@@ -0,0 +1,326 @@
+/**
+ * @file certificate.cpp
+ * @brief Max clique certificate implementation
+ */
+#include "certificate.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "checkpoint.hpp"
+
+using bits::Word;
+using std::invalid_argument;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// First word of every certificate file, then the format version
+constexpr std::string_view MAGIC = "clique-certificate";
+constexpr size_t VERSION = 1;
+
+// Node kinds in the file
+constexpr char COLORING = 'c';
+constexpr char BRANCHING = 'b';
+
+// The branch and bound again, closing every branch instead of looking for
+// anything
+class Prover {
+   private:
+    const bits::BitMatrix& adjacency;
+    size_t vertexCount;
+    vector<Word> uncolored;
+
+    // Greedy sequential coloring, the same as coloringBound, but keeping
+    // the classes
+    auto color(const vector<Word>& candidates) -> vector<vector<size_t>> {
+        vector<vector<size_t>> classes;
+        uncolored = candidates;
+        vector<Word> colorClass(uncolored.size());
+        while (!bits::none(uncolored)) {
+            auto& members = classes.emplace_back();
+            colorClass = uncolored;
+            for (size_t vertex = bits::nextSet(colorClass, 0);
+                 vertex < vertexCount;
+                 vertex = bits::nextSet(colorClass, vertex + 1)) {
+                members.push_back(vertex);
+                bits::reset(uncolored, vertex);
+                bits::andNot(colorClass, adjacency[vertex], colorClass);
+            }
+        }
+        return classes;
+    }
+
+   public:
+    explicit Prover(const bits::BitMatrix& adjacency)
+        : adjacency{adjacency},
+          vertexCount{adjacency.getSize()},
+          uncolored(adjacency.getStride()) {}
+
+    auto prove(vector<Word> candidates, size_t budget) -> ProofNode {
+        size_t count = bits::count(candidates);
+        if (count <= budget) {
+            return {};
+        }
+        if (budget == 0) {
+            throw invalid_argument{"Not a maximum clique"};
+        }
+
+        auto classes = color(candidates);
+        if (classes.size() <= budget) {
+            return {std::move(classes), {}};
+        }
+
+        // Same as the search, stop once what's left can't beat the budget
+        ProofNode node;
+        vector<Word> next(candidates.size());
+        for (size_t vertex = bits::nextSet(candidates, 0); count > budget;
+             vertex = bits::nextSet(candidates, vertex + 1), --count) {
+            bits::reset(candidates, vertex);
+            bits::intersect(candidates, adjacency[vertex], next);
+            node.children.push_back(prove(next, budget - 1));
+        }
+        return node;
+    }
+};
+
+// Goes through a proof the same way Prover made it
+class Checker {
+   private:
+    const bits::BitMatrix& adjacency;
+    size_t vertexCount;
+
+    [[nodiscard]] auto checkColoring(const ProofNode& node,
+                                     const vector<Word>& candidates,
+                                     size_t budget) const -> bool {
+        if (node.coloring.size() > budget || !node.children.empty()) {
+            return false;
+        }
+
+        // Every candidate in exactly one class, and no edges inside a class
+        vector<Word> covered(candidates.size());
+        vector<Word> members(candidates.size());
+        for (const auto& colorClass : node.coloring) {
+            std::ranges::fill(members, Word{0});
+            for (size_t vertex : colorClass) {
+                if (vertex >= vertexCount || !bits::test(candidates, vertex) ||
+                    bits::test(covered, vertex)) {
+                    return false;
+                }
+                bits::set(covered, vertex);
+                bits::set(members, vertex);
+            }
+            for (size_t vertex : colorClass) {
+                if (bits::intersectCount(members, adjacency[vertex]) > 0) {
+                    return false;
+                }
+            }
+        }
+        return bits::count(covered) == bits::count(candidates);
+    }
+
+   public:
+    explicit Checker(const bits::BitMatrix& adjacency)
+        : adjacency{adjacency}, vertexCount{adjacency.getSize()} {}
+
+    [[nodiscard]] auto check(const ProofNode& node, vector<Word> candidates,
+                             size_t budget) const -> bool {
+        if (!node.coloring.empty()) {
+            return checkColoring(node, candidates, budget);
+        }
+
+        // The candidates no child covers have to fit in the budget alone
+        size_t count = bits::count(candidates);
+        if (node.children.size() > count ||
+            count - node.children.size() > budget ||
+            (budget == 0 && !node.children.empty())) {
+            return false;
+        }
+
+        vector<Word> next(candidates.size());
+        size_t vertex = 0;
+        for (const auto& child : node.children) {
+            vertex = bits::nextSet(candidates, vertex);
+            bits::reset(candidates, vertex);
+            bits::intersect(candidates, adjacency[vertex], next);
+            if (!check(child, next, budget - 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+auto writeVertices(std::ostream& stream, const vector<size_t>& vertices)
+    -> void {
+    stream << vertices.size();
+    for (size_t vertex : vertices) {
+        stream << ' ' << vertex;
+    }
+}
+
+auto readVertices(std::istream& stream, size_t vertexCount) -> vector<size_t> {
+    size_t count = 0;
+    if (!(stream >> count) || count > vertexCount) {
+        throw invalid_argument("Failed to read certificate");
+    }
+
+    vector<size_t> vertices(count);
+    for (auto& vertex : vertices) {
+        if (!(stream >> vertex) || vertex >= vertexCount) {
+            throw invalid_argument("Failed to read certificate");
+        }
+    }
+    return vertices;
+}
+
+// Preorder, one line per node
+auto writeNode(std::ostream& stream, const ProofNode& node) -> void {
+    if (!node.coloring.empty()) {
+        stream << COLORING << ' ' << node.coloring.size();
+        for (const auto& colorClass : node.coloring) {
+            stream << ' ';
+            writeVertices(stream, colorClass);
+        }
+        stream << '\n';
+        return;
+    }
+
+    stream << BRANCHING << ' ' << node.children.size() << '\n';
+    for (const auto& child : node.children) {
+        writeNode(stream, child);
+    }
+}
+
+// No proof goes deeper than the graph has vertices, so neither does this
+auto readNode(std::istream& stream, size_t vertexCount, size_t depth)
+    -> ProofNode {
+    char kind = 0;
+    size_t count = 0;
+    if (depth > vertexCount || !(stream >> kind >> count) ||
+        count > vertexCount) {
+        throw invalid_argument("Failed to read certificate");
+    }
+
+    ProofNode node;
+    if (kind == COLORING) {
+        for (size_t i = 0; i < count; ++i) {
+            node.coloring.push_back(readVertices(stream, vertexCount));
+        }
+    } else if (kind == BRANCHING) {
+        for (size_t i = 0; i < count; ++i) {
+            node.children.push_back(readNode(stream, vertexCount, depth + 1));
+        }
+    } else {
+        throw invalid_argument("Failed to read certificate");
+    }
+    return node;
+}
+
+}  // namespace
+
+auto certifyClique(const bits::BitMatrix& adjacency, vector<size_t> clique)
+    -> CliqueCertificate {
+    size_t vertexCount = adjacency.getSize();
+    std::ranges::sort(clique);
+    for (size_t i = 0; i < clique.size(); ++i) {
+        if (clique[i] >= vertexCount ||
+            (i > 0 && clique[i] == clique[i - 1])) {
+            throw invalid_argument{"Not a clique"};
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (!adjacency.test(clique[i], clique[j])) {
+                throw invalid_argument{"Not a clique"};
+            }
+        }
+    }
+
+    vector<Word> everything(adjacency.getStride());
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(everything, vertex);
+    }
+
+    auto proof = Prover{adjacency}.prove(std::move(everything), clique.size());
+    return {vertexCount, fingerprint(adjacency), std::move(clique),
+            std::move(proof)};
+}
+
+auto verifyCertificate(const bits::BitMatrix& adjacency,
+                       const CliqueCertificate& certificate) -> bool {
+    size_t vertexCount = adjacency.getSize();
+    if (certificate.vertexCount != vertexCount ||
+        certificate.fingerprint != fingerprint(adjacency)) {
+        return false;
+    }
+
+    const auto& clique = certificate.clique;
+    for (size_t i = 0; i < clique.size(); ++i) {
+        if (clique[i] >= vertexCount) {
+            return false;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (!adjacency.test(clique[i], clique[j])) {
+                return false;
+            }
+        }
+    }
+
+    vector<Word> everything(adjacency.getStride());
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(everything, vertex);
+    }
+    return Checker{adjacency}.check(certificate.proof, std::move(everything),
+                                    clique.size());
+}
+
+auto saveCertificate(const CliqueCertificate& certificate,
+                     const std::string& path) -> void {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file{temporary};
+        file << MAGIC << ' ' << VERSION << '\n'
+             << certificate.vertexCount << ' ' << certificate.fingerprint
+             << '\n';
+        writeVertices(file, certificate.clique);
+        file << '\n';
+        writeNode(file, certificate.proof);
+
+        if (!file.flush()) {
+            throw std::runtime_error("Failed to write certificate");
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        throw std::runtime_error("Failed to write certificate");
+    }
+}
+
+auto loadCertificate(const std::string& path) -> CliqueCertificate {
+    std::ifstream file{path};
+    if (!file.is_open()) {
+        throw invalid_argument("Failed to open certificate");
+    }
+
+    std::string magic;
+    size_t version = 0;
+    if (!(file >> magic >> version) || magic != MAGIC || version != VERSION) {
+        throw invalid_argument("Not a certificate");
+    }
+
+    CliqueCertificate certificate;
+    if (!(file >> certificate.vertexCount >> certificate.fingerprint)) {
+        throw invalid_argument("Failed to read certificate");
+    }
+    certificate.clique = readVertices(file, certificate.vertexCount);
+    certificate.proof = readNode(file, certificate.vertexCount, 0);
+    return certificate;
+}
+
+}  // namespace clique
@@ -0,0 +1,129 @@
+/**
+ * @file checkpoint.cpp
+ * @brief Search state file implementation
+ */
+#include "checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+using std::invalid_argument;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// First word of every state file, then the format version
+constexpr std::string_view MAGIC = "clique-search-state";
+constexpr size_t VERSION = 1;
+
+constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+auto writeVertices(std::ostream& stream, const vector<size_t>& vertices)
+    -> void {
+    stream << vertices.size();
+    for (size_t vertex : vertices) {
+        stream << ' ' << vertex;
+    }
+}
+
+auto readVertices(std::istream& stream, size_t vertexCount) -> vector<size_t> {
+    size_t count = 0;
+    if (!(stream >> count) || count > vertexCount) {
+        throw invalid_argument("Failed to read search state");
+    }
+
+    vector<size_t> vertices(count);
+    for (auto& vertex : vertices) {
+        if (!(stream >> vertex) || vertex >= vertexCount) {
+            throw invalid_argument("Failed to read search state");
+        }
+    }
+    return vertices;
+}
+
+}  // namespace
+
+auto fingerprint(const bits::BitMatrix& adjacency) -> std::uint64_t {
+    std::uint64_t hash = FNV_OFFSET;
+    for (size_t row = 0; row < adjacency.getSize(); ++row) {
+        for (bits::Word word : adjacency[row]) {
+            hash = (hash ^ word) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+auto saveState(const SearchState& state, const std::string& path) -> void {
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file{temporary};
+        file << MAGIC << ' ' << VERSION << '\n'
+             << state.kind << ' ' << state.vertexCount << ' '
+             << state.fingerprint << '\n'
+             << state.incumbents.size() << '\n';
+        for (const auto& incumbent : state.incumbents) {
+            writeVertices(file, incumbent);
+            file << '\n';
+        }
+
+        file << state.frontier.size() << '\n';
+        for (const auto& task : state.frontier) {
+            writeVertices(file, task.clique);
+            file << ' ';
+            writeVertices(file, task.candidates);
+            file << '\n';
+        }
+
+        if (!file.flush()) {
+            throw std::runtime_error("Failed to write search state");
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        throw std::runtime_error("Failed to write search state");
+    }
+}
+
+auto loadState(const std::string& path) -> SearchState {
+    std::ifstream file{path};
+    if (!file.is_open()) {
+        throw invalid_argument("Failed to open search state");
+    }
+
+    std::string magic;
+    size_t version = 0;
+    if (!(file >> magic >> version) || magic != MAGIC || version != VERSION) {
+        throw invalid_argument("Not a search state");
+    }
+
+    SearchState state;
+    size_t incumbentCount = 0;
+    if (!(file >> state.kind >> state.vertexCount >> state.fingerprint >>
+          incumbentCount)) {
+        throw invalid_argument("Failed to read search state");
+    }
+    for (size_t i = 0; i < incumbentCount; ++i) {
+        state.incumbents.push_back(readVertices(file, state.vertexCount));
+    }
+
+    size_t taskCount = 0;
+    if (!(file >> taskCount)) {
+        throw invalid_argument("Failed to read search state");
+    }
+    for (size_t i = 0; i < taskCount; ++i) {
+        auto clique = readVertices(file, state.vertexCount);
+        state.frontier.push_back(
+            {std::move(clique), readVertices(file, state.vertexCount)});
+    }
+
+    return state;
+}
+
+}  // namespace clique
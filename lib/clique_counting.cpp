@@ -0,0 +1,217 @@
+/**
+ * @file clique_counting.cpp
+ * @brief Clique counting implementation
+ */
+#include "clique_counting.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <span>
+
+#include "bitset.hpp"
+#include "maximal_cliques.hpp"
+#include "work_stealing.hpp"
+
+using bits::Word;
+using std::span;
+using std::uint64_t;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// localIndex of a vertex that isn't a later neighbour of the current one
+constexpr size_t NOT_LOCAL = std::numeric_limits<size_t>::max();
+
+// Counts the cliques starting at one vertex at a time, with buffers sized
+// for the biggest neighbourhood up front, like NeighbourhoodSearch
+class Counter {
+   private:
+    const vector<vector<size_t>>& later;
+    vector<CliqueCounts>& counts;
+    vector<uint64_t>& totals;
+    size_t maxSize;
+
+    // The current vertex's later neighbours, and each one's index among
+    // them. Rows of local only have the neighbours after that one.
+    vector<size_t> localIndex;
+    size_t localStride{0};
+    bits::BitMatrix local;
+
+    // Per clique size so far: what can still join, and how many cliques of
+    // each size there are with some of those
+    bits::BitMatrix candidates;
+    vector<vector<uint64_t>> found;
+
+    // Cliques per local vertex and size, the current vertex itself first
+    vector<uint64_t> participation;
+
+    auto row(bits::BitMatrix& matrix, size_t index) -> span<Word> {
+        return matrix[index].first(localStride);
+    }
+
+    auto participate(size_t index, size_t size, uint64_t count) -> void {
+        participation[(index * (maxSize + 1)) + size] += count;
+    }
+
+    // Counts the cliques made of the current size vertices and any of
+    // candidates[size], into found[size]
+    auto extend(size_t size, size_t localCount) -> void {
+        auto& here = found[size];
+        std::ranges::fill(here, 0);
+        here[size] = 1;
+        if (size == maxSize) {
+            return;
+        }
+
+        auto options = row(candidates, size);
+        if (size + 1 == maxSize) {
+            // Any one of them makes a clique, no need to go in
+            here[maxSize] = bits::count(options);
+            for (size_t vertex = bits::nextSet(options, 0);
+                 vertex < localCount;
+                 vertex = bits::nextSet(options, vertex + 1)) {
+                participate(vertex + 1, maxSize, 1);
+            }
+            return;
+        }
+
+        for (size_t vertex = bits::nextSet(options, 0); vertex < localCount;
+             vertex = bits::nextSet(options, vertex + 1)) {
+            bits::intersect(options, row(local, vertex),
+                            row(candidates, size + 1));
+            extend(size + 1, localCount);
+
+            const auto& child = found[size + 1];
+            for (size_t bigger = size + 1; bigger <= maxSize; ++bigger) {
+                here[bigger] += child[bigger];
+                participate(vertex + 1, bigger, child[bigger]);
+            }
+        }
+    }
+
+   public:
+    Counter(const vector<vector<size_t>>& later, vector<CliqueCounts>& counts,
+            vector<uint64_t>& totals, size_t maxSize, size_t maxOutDegree)
+        : later{later},
+          counts{counts},
+          totals{totals},
+          maxSize{maxSize},
+          localIndex(later.size(), NOT_LOCAL),
+          local{maxOutDegree},
+          candidates{maxSize + 1, maxOutDegree},
+          found(maxSize + 1, vector<uint64_t>(maxSize + 1)),
+          participation((maxOutDegree + 1) * (maxSize + 1)) {}
+
+    auto count(size_t vertex) -> void {
+        const auto& neighbours = later[vertex];
+        size_t localCount = neighbours.size();
+        localStride = bits::wordsFor(localCount);
+        for (size_t i = 0; i < localCount; ++i) {
+            localIndex[neighbours[i]] = i;
+        }
+
+        // Both ends of every edge in here are later neighbours, and the
+        // earlier end has the later one in its list
+        for (size_t i = 0; i < localCount; ++i) {
+            auto localRow = row(local, i);
+            std::ranges::fill(localRow, 0);
+            for (size_t other : later[neighbours[i]]) {
+                if (localIndex[other] != NOT_LOCAL) {
+                    bits::set(localRow, localIndex[other]);
+                }
+            }
+        }
+
+        auto everything = row(candidates, 1);
+        std::ranges::fill(everything, 0);
+        for (size_t i = 0; i < localCount; ++i) {
+            bits::set(everything, i);
+        }
+
+        std::fill_n(participation.begin(), (localCount + 1) * (maxSize + 1),
+                    0);
+        extend(1, localCount);
+        for (size_t size = 1; size <= maxSize; ++size) {
+            totals[size] += found[1][size];
+            participate(0, size, found[1][size]);
+        }
+
+        // Every thread adds into the same counts, but only once per vertex
+        // and size, not once per clique
+        for (size_t i = 0; i <= localCount; ++i) {
+            size_t member = i == 0 ? vertex : neighbours[i - 1];
+            for (size_t size = 1; size <= maxSize; ++size) {
+                if (uint64_t count = participation[(i * (maxSize + 1)) + size];
+                    count > 0) {
+                    std::atomic_ref{counts[size].perVertex[member]}.fetch_add(
+                        count, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        for (size_t other : neighbours) {
+            localIndex[other] = NOT_LOCAL;
+        }
+    }
+};
+
+}  // namespace
+
+auto countCliques(const vector<vector<size_t>>& neighbours, size_t maxSize,
+                  size_t threadCount) -> vector<CliqueCounts> {
+    size_t vertexCount = neighbours.size();
+    vector<CliqueCounts> counts(maxSize + 1);
+    for (auto& count : counts) {
+        count.perVertex.resize(vertexCount);
+    }
+    counts[0].total = 1;
+    if (maxSize == 0 || vertexCount == 0) {
+        return counts;
+    }
+
+    // Each edge only from its earlier end, later ends in order
+    auto order = degeneracyOrder(neighbours);
+    vector<size_t> position(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        position[order[i]] = i;
+    }
+    vector<vector<size_t>> later(vertexCount);
+    size_t maxOutDegree = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        for (size_t other : neighbours[vertex]) {
+            if (position[other] > position[vertex]) {
+                later[vertex].push_back(other);
+            }
+        }
+        std::ranges::sort(later[vertex], {},
+                          [&](size_t other) { return position[other]; });
+        maxOutDegree = std::max(maxOutDegree, later[vertex].size());
+    }
+
+    WorkStealingPool<size_t> pool{threadCount};
+    size_t workerCount = pool.getWorkerCount();
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        pool.push(vertex % workerCount, vertex);
+    }
+
+    vector<vector<uint64_t>> totals(workerCount,
+                                    vector<uint64_t>(maxSize + 1));
+    pool.run([&](size_t worker) {
+        return [counter = Counter{later, counts, totals[worker], maxSize,
+                                  maxOutDegree}](size_t&& vertex) mutable {
+            counter.count(vertex);
+        };
+    });
+
+    for (const auto& workerTotals : totals) {
+        for (size_t size = 1; size <= maxSize; ++size) {
+            counts[size].total += workerTotals[size];
+        }
+    }
+    return counts;
+}
+
+}  // namespace clique
@@ -5,16 +5,33 @@
 #include "graph.hpp"
 
 #include <algorithm>
+#include <array>
+#include <condition_variable>
 #include <iostream>
+#include <limits>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 
+#include "checkpoint.hpp"
+#include "color_refinement.hpp"
+#include "independent_set.hpp"
+#include "local_search.hpp"
+#include "maximal_cliques.hpp"
+#include "russian_doll.hpp"
+#include "symmetry.hpp"
+#include "vertex_cover.hpp"
+#include "weighted_clique.hpp"
+#include "work_stealing.hpp"
+
 using std::cin;
 using std::cout;
 using std::ifstream;
 using std::invalid_argument;
+using std::span;
 using std::string;
 using std::swap;
 using std::vector;
@@ -22,7 +39,116 @@ using std::vector;
 using std::ranges::all_of;
 using std::ranges::any_of;
 using std::ranges::max_element;
-using std::ranges::next_permutation;
+
+using bits::Word;
+
+namespace {
+
+// The same graph as adjacency lists, for the engines that want those
+auto adjacencyLists(const bits::BitMatrix& adjacency)
+    -> vector<vector<size_t>> {
+    size_t vertexCount = adjacency.getSize();
+    vector<vector<size_t>> neighbours(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        for (size_t other = bits::nextSet(adjacency[vertex], 0);
+             other < vertexCount;
+             other = bits::nextSet(adjacency[vertex], other + 1)) {
+            neighbours[vertex].push_back(other);
+        }
+    }
+    return neighbours;
+}
+
+// What "--engine" takes
+struct EngineName {
+    std::string_view name;
+    CliqueEngine engine;
+};
+
+constexpr std::array ENGINE_NAMES{
+    EngineName{"auto", CliqueEngine::AUTO},
+    EngineName{"branch-and-bound", CliqueEngine::BRANCH_AND_BOUND},
+    EngineName{"russian-doll", CliqueEngine::RUSSIAN_DOLL},
+    EngineName{"complement", CliqueEngine::COMPLEMENT},
+    EngineName{"portfolio", CliqueEngine::PORTFOLIO},
+};
+
+// Names for "--explain"
+auto engineName(CliqueEngine engine) -> const char* {
+    switch (engine) {
+        case CliqueEngine::AUTO:
+            return "auto";
+        case CliqueEngine::BRANCH_AND_BOUND:
+            return "branch and bound";
+        case CliqueEngine::RUSSIAN_DOLL:
+            return "russian doll";
+        case CliqueEngine::COMPLEMENT:
+            return "independent set on the complement";
+        case CliqueEngine::PORTFOLIO:
+            return "portfolio";
+    }
+    return "?";
+}
+
+auto storageName(GraphStorage storage) -> const char* {
+    switch (storage) {
+        case GraphStorage::DENSE:
+            return "dense matrix";
+        case GraphStorage::FIXED_BITSET:
+            return "fixed width bitsets";
+        case GraphStorage::BITSET:
+            return "bitsets";
+        case GraphStorage::SPARSE:
+            return "neighbour lists";
+    }
+    return "?";
+}
+
+auto orderName(VertexOrder order) -> const char* {
+    switch (order) {
+        case VertexOrder::NATURAL:
+            return "natural order";
+        case VertexOrder::DEGREE:
+            return "degree order";
+        case VertexOrder::DEGENERACY:
+            return "degeneracy order";
+    }
+    return "?";
+}
+
+}  // namespace
+
+[[nodiscard]] auto parseCliqueEngine(std::string_view name)
+    -> std::optional<CliqueEngine> {
+    const auto* found = std::ranges::find(ENGINE_NAMES, name,
+                                          &EngineName::name);
+    if (found == ENGINE_NAMES.end()) {
+        return std::nullopt;
+    }
+    return found->engine;
+}
+
+auto operator<<(std::ostream& outputStream, const SearchPlan& plan)
+    -> std::ostream& {
+    const auto& statistics = plan.statistics;
+    outputStream << plan.operation << ": " << statistics.vertexCount
+                 << " vertices, " << statistics.edgeCount << " edges, density "
+                 << statistics.density << ", complement density "
+                 << statistics.complementDensity << ", max degree "
+                 << statistics.maxDegree << ", degeneracy "
+                 << statistics.degeneracy << ", "
+                 << (statistics.symmetric ? "symmetric" : "no symmetry found")
+                 << "\n  "
+                 << (plan.accuracy == AlgorithmAccuracy::APPROXIMATE
+                         ? "approximate"
+                         : "exact");
+    if (plan.engine) {
+        outputStream << ", " << engineName(*plan.engine);
+    }
+    return outputStream << ", " << storageName(plan.storage) << ", "
+                        << orderName(plan.order) << " (" << plan.reason
+                        << ")\n";
+}
 
 Graph::Graph(const std::vector<std::vector<int>>&& adjacencyMatrix)
     : vertexCount{adjacencyMatrix.size()},
@@ -33,6 +159,8 @@ Graph::Graph(const std::vector<std::vector<int>>&& adjacencyMatrix)
             vertexAndEdgeCount += adjacencyMatrix[i][j];
         }
     }
+
+    buildAdjacencyBits();
 }
 
 Graph::Graph(std::istream& graphStream) : Graph{} {
@@ -56,6 +184,39 @@ Graph::Graph(std::istream& graphStream) : Graph{} {
             vertexAndEdgeCount += adjacencyMatrix[i][j];
         }
     }
+
+    buildAdjacencyBits();
+}
+
+auto Graph::buildAdjacencyBits() -> void {
+    successorBits = bits::BitMatrix{vertexCount};
+    predecessorBits = bits::BitMatrix{vertexCount};
+
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = 0; j < vertexCount; ++j) {
+            if (adjacencyMatrix[i][j] > 0) {
+                successorBits.set(i, j);
+                predecessorBits.set(j, i);
+            }
+        }
+    }
+}
+
+template <typename Adjacency>
+auto Graph::cliqueAdjacency(auto& adjacency) const -> void {
+    size_t stride = successorBits.getStride();
+
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        // The fixed size rows can be wider than ours, their tail stays 0
+        auto row = span<Word>{adjacency[vertex]}.first(stride);
+        for (size_t word = 0; word < stride; ++word) {
+            row[word] = Adjacency::combine(successorBits[vertex][word],
+                                           predecessorBits[vertex][word]);
+        }
+
+        // Self-loops don't matter for cliques
+        bits::reset(row, vertex);
+    }
 }
 
 [[nodiscard]] auto Graph::getSize() const -> size_t {
@@ -116,26 +277,130 @@ auto operator<<(std::ostream& outputStream, const Graph& graph)
 // We say that Graph equality is true for isomorphisms
 [[nodiscard]] auto operator==(const Graph& lhs, const Graph& rhs) -> bool {
     // Different-sized graphs are trivially non-isomorphic
-    if (lhs.getSize() != rhs.getSize()) {
+    if (lhs.getSize() != rhs.getSize() || lhs.vertexCount != rhs.vertexCount) {
         return false;
     }
 
-    vector<size_t> permutation(lhs.vertexCount);
-    std::iota(permutation.begin(), permutation.end(), 0);
-    auto isPermutationOf = [&permutation](const Graph& lhs, const Graph& rhs) {
-        return all_of(permutation, [&](size_t lhsPos) {
-            return all_of(permutation, [&](size_t rhsPos) {
-                return lhs[lhsPos][rhsPos] ==
-                       rhs[permutation[lhsPos]][permutation[rhsPos]];
-            });
-        });
-    };
+    size_t vertexCount = lhs.vertexCount;
+    vector<size_t> lhsColors(vertexCount);
+    vector<size_t> rhsColors(vertexCount);
+    size_t colorCount = 0;
+
+    // Small graphs get their rows copied into fixed size sets first,
+    // so all the counting below is unrolled
+    bits::withFixedWords(vertexCount, [&]<size_t Words>(
+                                          std::integral_constant<size_t,
+                                                                 Words>) {
+        constexpr size_t ROWS = Words * bits::WORD_BITS;
+        ColorRefinement<Words> refinement{vertexCount};
+
+        // Start off by colouring vertices with some cheap invariants,
+        // then refine until the colours stop splitting
+        constexpr size_t INITIAL_WIDTH = 5;
+        refinement.startSignatures(INITIAL_WIDTH);
+        for (const Graph* graph : {&lhs, &rhs}) {
+            size_t offset = graph == &lhs ? 0 : vertexCount;
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                size_t outWeight = 0;
+                size_t inWeight = 0;
+                for (size_t other = 0; other < vertexCount; ++other) {
+                    outWeight += static_cast<size_t>(
+                        graph->adjacencyMatrix[vertex][other]);
+                    inWeight += static_cast<size_t>(
+                        graph->adjacencyMatrix[other][vertex]);
+                }
+
+                auto signature = refinement.signature(offset + vertex);
+                signature[0] = static_cast<size_t>(
+                    graph->adjacencyMatrix[vertex][vertex]);
+                signature[1] = bits::count(graph->successorBits[vertex]);
+                signature[2] = bits::count(graph->predecessorBits[vertex]);
+                signature[3] = outWeight;
+                signature[4] = inWeight;
+            }
+        }
+        colorCount = refinement.recolor();
+
+        auto lhsSuccessors = bits::copyRows<Words, ROWS>(lhs.successorBits);
+        auto lhsPredecessors = bits::copyRows<Words, ROWS>(lhs.predecessorBits);
+        auto rhsSuccessors = bits::copyRows<Words, ROWS>(rhs.successorBits);
+        auto rhsPredecessors = bits::copyRows<Words, ROWS>(rhs.predecessorBits);
+
+        for (;;) {
+            size_t refinedColorCount =
+                refinement.refine(lhsSuccessors, lhsPredecessors,
+                                  rhsSuccessors, rhsPredecessors);
+            if (refinedColorCount == colorCount) {
+                break;
+            }
+            colorCount = refinedColorCount;
+        }
 
-    bool permutationWasFound = isPermutationOf(lhs, rhs);
-    while (!permutationWasFound && next_permutation(permutation).found) {
-        permutationWasFound = isPermutationOf(lhs, rhs);
+        auto colors = refinement.getColors();
+        std::ranges::copy(colors.first(vertexCount), lhsColors.begin());
+        std::ranges::copy(colors.last(vertexCount), rhsColors.begin());
+    });
+
+    // Colour classes of different sizes can't be matched up at all
+    vector<size_t> lhsHistogram(colorCount);
+    vector<size_t> rhsHistogram(colorCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        ++lhsHistogram[lhsColors[vertex]];
+        ++rhsHistogram[rhsColors[vertex]];
+    }
+    if (lhsHistogram != rhsHistogram) {
+        return false;
     }
 
+    // Map the most constrained (smallest class) vertices first
+    vector<size_t> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](size_t first, size_t second) {
+        return lhsHistogram[lhsColors[first]] <
+               lhsHistogram[lhsColors[second]];
+    });
+
+    // permutation[lhsPos] == rhsPos, only ever within the same colour
+    vector<size_t> permutation(vertexCount);
+    vector<bool> rhsUsed(vertexCount);
+    auto extend = [&](auto& self, size_t depth) -> bool {
+        if (depth == vertexCount) {
+            return true;
+        }
+
+        size_t lhsPos = order[depth];
+        for (size_t rhsPos = 0; rhsPos < vertexCount; ++rhsPos) {
+            if (rhsUsed[rhsPos] || rhsColors[rhsPos] != lhsColors[lhsPos] ||
+                lhs.adjacencyMatrix[lhsPos][lhsPos] !=
+                    rhs.adjacencyMatrix[rhsPos][rhsPos]) {
+                continue;
+            }
+
+            bool consistent = all_of(
+                span<const size_t>{order}.first(depth), [&](size_t mappedPos) {
+                    size_t mappedImage = permutation[mappedPos];
+                    return lhs.adjacencyMatrix[lhsPos][mappedPos] ==
+                               rhs.adjacencyMatrix[rhsPos][mappedImage] &&
+                           lhs.adjacencyMatrix[mappedPos][lhsPos] ==
+                               rhs.adjacencyMatrix[mappedImage][rhsPos];
+                });
+            if (!consistent) {
+                continue;
+            }
+
+            permutation[lhsPos] = rhsPos;
+            rhsUsed[rhsPos] = true;
+            if (self(self, depth + 1)) {
+                return true;
+            }
+            rhsUsed[rhsPos] = false;
+        }
+
+        return false;
+    };
+
+    bool permutationWasFound = extend(extend, 0);
+
     // Show the permuation if we found it
 #if DEBUG
     if (permutationWasFound) {
@@ -163,131 +428,1306 @@ auto operator<<(std::ostream& outputStream, const Graph& graph)
 }
 
 [[nodiscard]] auto Graph::modularProduct(const Graph& rhs) -> Graph {
+    // A negative weight is neither an edge nor a non-edge, so there's no
+    // telling what it should pair up with
+    for (const Graph* graph : {static_cast<const Graph*>(this), &rhs}) {
+        for (const auto& row : graph->adjacencyMatrix) {
+            if (any_of(row, [](int weight) { return weight < 0; })) {
+                throw invalid_argument("Negative edge weight");
+            }
+        }
+    }
+
     size_t rhsVertexCount = rhs.vertexCount;
     size_t resultGraphVertexCount = vertexCount * rhsVertexCount;
-    size_t minVertexCount = std::min(vertexCount, rhsVertexCount);
-    size_t maxVertexCount = std::max(vertexCount, rhsVertexCount);
 
     vector<vector<int>> adjacencyMatrixOfResultGraph(
         resultGraphVertexCount, vector<int>(resultGraphVertexCount));
 
-    for (size_t row = 0; row < resultGraphVertexCount; ++row) {
-        for (size_t col = 0; col < resultGraphVertexCount; ++col) {
-            size_t lhsRow = 0;
-            size_t lhsCol = 0;
-            size_t rhsRow = 0;
-            size_t rhsCol = 0;
-
-            if (vertexCount == minVertexCount) {
-                lhsRow = row / maxVertexCount;
-                lhsCol = col / maxVertexCount;
-                rhsRow = row % maxVertexCount;
-                rhsCol = col % maxVertexCount;
-            } else {
-                lhsRow = row / minVertexCount;
-                lhsCol = col / minVertexCount;
-                rhsRow = row % minVertexCount;
-                rhsCol = col % minVertexCount;
+    // Vertex (lhsVertex, rhsVertex) of the product is numbered
+    // lhsVertex * rhsVertexCount + rhsVertex.
+    // For a fixed pair of rows, an lhs edge pairs up with exactly the rhs
+    // edges and an lhs non-edge with exactly the rhs non-edges, so we build
+    // those two column sets once and only visit the entries that end up
+    // nonzero.
+    bits::withFixedWords(rhsVertexCount, [&]<size_t Words>(
+                                             std::integral_constant<size_t,
+                                                                    Words>) {
+        constexpr size_t ROWS = Words * bits::WORD_BITS;
+        auto rhsEdges = bits::copyRows<Words, ROWS>(rhs.successorBits);
+
+        // Rows: every rhs vertex, then columns paired with an lhs edge,
+        // then columns paired with an lhs non-edge
+        bits::BitRows<Words, 3> columns{3, rhsVertexCount};
+        auto&& allColumns = columns[0];
+        auto&& edgeColumns = columns[1];
+        auto&& nonEdgeColumns = columns[2];
+        for (size_t rhsCol = 0; rhsCol < rhsVertexCount; ++rhsCol) {
+            bits::set(allColumns, rhsCol);
+        }
+
+        for (size_t rhsRow = 0; rhsRow < rhsVertexCount; ++rhsRow) {
+            std::ranges::copy(rhsEdges[rhsRow], edgeColumns.begin());
+            bits::reset(edgeColumns, rhsRow);
+            bits::andNot(allColumns, rhsEdges[rhsRow], nonEdgeColumns);
+            bits::reset(nonEdgeColumns, rhsRow);
+
+            for (size_t lhsRow = 0; lhsRow < vertexCount; ++lhsRow) {
+                auto& resultRow =
+                    adjacencyMatrixOfResultGraph[lhsRow * rhsVertexCount +
+                                                 rhsRow];
+                for (size_t lhsCol = 0; lhsCol < vertexCount; ++lhsCol) {
+                    if (lhsCol == lhsRow) {
+                        continue;
+                    }
+
+                    int lhsWeight = adjacencyMatrix[lhsRow][lhsCol];
+                    const auto& pairedColumns =
+                        lhsWeight > 0 ? edgeColumns : nonEdgeColumns;
+                    for (size_t rhsCol = bits::nextSet(pairedColumns, 0);
+                         rhsCol < rhsVertexCount;
+                         rhsCol = bits::nextSet(pairedColumns, rhsCol + 1)) {
+                        resultRow[lhsCol * rhsVertexCount + rhsCol] =
+                            lhsWeight > 0
+                                ? std::min(lhsWeight,
+                                           rhs.adjacencyMatrix[rhsRow][rhsCol])
+                                : 1;
+                    }
+                }
             }
+        }
+    });
 
-            if (row == col || rhsRow == rhsCol || lhsRow == lhsCol) {
-                continue;
+    return Graph{std::move(adjacencyMatrixOfResultGraph)};
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::planCliqueSearch(std::string operation,
+                             AlgorithmAccuracy accuracy, CliqueEngine engine,
+                             size_t threadCount, bool ordered,
+                             size_t symmetryRounds) const -> SearchPlan {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<Adjacency>(adjacency);
+
+    auto bitset = vertexCount <= bits::MAX_FIXED_BITS
+                      ? GraphStorage::FIXED_BITSET
+                      : GraphStorage::BITSET;
+    SearchPlan plan{std::move(operation),
+                    clique::measureStatistics(adjacency, symmetryRounds),
+                    accuracy,
+                    std::nullopt,
+                    bitset,
+                    VertexOrder::NATURAL,
+                    "",
+                    {},
+                    std::nullopt};
+    const auto& statistics = plan.statistics;
+
+    if (accuracy == AlgorithmAccuracy::APPROXIMATE) {
+        plan.storage = GraphStorage::BITSET;
+        plan.reason = "asked for";
+        return plan;
+    }
+
+    // Only the branch and bound can keep ties, on its own or racing itself
+    if (Ties::KEEPS_TIES && engine != CliqueEngine::PORTFOLIO) {
+        plan.engine = CliqueEngine::BRANCH_AND_BOUND;
+        plan.reason = "keeping ties";
+    } else if (engine != CliqueEngine::AUTO) {
+        plan.engine = engine;
+        plan.reason = "asked for";
+    } else if (statistics.complementDensity <= COMPLEMENT_DENSITY_THRESHOLD) {
+        plan.engine = CliqueEngine::COMPLEMENT;
+        plan.reason = "sparse complement";
+    } else if (statistics.density <= RUSSIAN_DOLL_DENSITY_THRESHOLD &&
+               threadCount <= 1 && !ordered) {
+        plan.engine = CliqueEngine::RUSSIAN_DOLL;
+        plan.reason = "sparse, the coloring wouldn't prune much";
+    } else {
+        plan.engine = CliqueEngine::BRANCH_AND_BOUND;
+        plan.reason = "neither it nor its complement is sparse";
+    }
+
+    // Only now that it's known which search would run
+    plan.accuracy = resolveAccuracy<Adjacency, Ties>(accuracy, *plan.engine,
+                                                     plan.incumbents);
+    if (plan.accuracy == AlgorithmAccuracy::APPROXIMATE) {
+        plan.engine.reset();
+        plan.storage = GraphStorage::BITSET;
+        plan.reason = "exact search estimated over budget";
+        return plan;
+    }
+    if (accuracy == AlgorithmAccuracy::AUTO &&
+        *plan.engine == CliqueEngine::COMPLEMENT) {
+        plan.timeLimit = exactBudget;
+        plan.reason += ", no estimate, stops at the budget";
+    }
+
+    switch (*plan.engine) {
+        case CliqueEngine::AUTO:
+        case CliqueEngine::BRANCH_AND_BOUND:
+            if (threadCount > 1 && !ordered) {
+                plan.order = VertexOrder::DEGREE;
             }
+            break;
+        case CliqueEngine::RUSSIAN_DOLL:
+            plan.storage = GraphStorage::BITSET;
+            plan.order = VertexOrder::DEGENERACY;
+            break;
+        case CliqueEngine::COMPLEMENT:
+            plan.storage = GraphStorage::SPARSE;
+            break;
+        case CliqueEngine::PORTFOLIO:
+            plan.order = VertexOrder::DEGREE;
+            break;
+    }
+    return plan;
+}
 
-            adjacencyMatrixOfResultGraph[row][col] =
-                std::min(adjacencyMatrix[lhsRow][lhsCol], rhs[rhsRow][rhsCol]);
+auto Graph::planModifiedSearch(std::string operation,
+                               AlgorithmAccuracy accuracy, size_t threadCount,
+                               CliqueEngine engine, size_t symmetryRounds) const
+    -> SearchPlan {
+    auto plan = planCliqueSearch<clique::EitherAdjacency, clique::KeepTies>(
+        std::move(operation), accuracy, engine, threadCount, false,
+        symmetryRounds);
+    if (plan.accuracy == AlgorithmAccuracy::EXACT && threadCount <= 1 &&
+        engine != CliqueEngine::PORTFOLIO) {
+        plan.storage = GraphStorage::DENSE;
+        plan.reason = "weighted search, tie-break as it goes";
+    }
+    return plan;
+}
+
+[[nodiscard]] auto Graph::planMaxClique(AlgorithmAccuracy accuracy,
+                                        size_t threadCount,
+                                        CliqueEngine engine) const
+    -> SearchPlan {
+    return planCliqueSearch<clique::MutualAdjacency, clique::IgnoreTies>(
+        "maxClique", accuracy, engine, threadCount, false,
+        SYMMETRY_SEARCH_ROUNDS);
+}
+
+[[nodiscard]] auto Graph::planMaxSubgraph(const Graph& rhs,
+                                          AlgorithmAccuracy accuracy,
+                                          size_t threadCount,
+                                          CliqueEngine engine) -> SearchPlan {
+    Graph modProd = modularProduct(rhs);
+    modProd.setExactBudget(exactBudget);
+    return modProd.planModifiedSearch("maxSubgraph", accuracy, threadCount,
+                                      engine, SYMMETRY_SEARCH_ROUNDS);
+}
+
+[[nodiscard]] auto Graph::planIsomorphism(const Graph& rhs) const
+    -> SearchPlan {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::EitherAdjacency>(adjacency);
+
+    SearchPlan plan{"operator==",
+                    clique::measureStatistics(adjacency, SYMMETRY_SEARCH_ROUNDS),
+                    AlgorithmAccuracy::EXACT,
+                    std::nullopt,
+                    vertexCount <= bits::MAX_FIXED_BITS
+                        ? GraphStorage::FIXED_BITSET
+                        : GraphStorage::BITSET,
+                    VertexOrder::NATURAL,
+                    "colour refinement, then backtracking in the classes",
+                    {},
+                    std::nullopt};
+    if (getSize() != rhs.getSize() || vertexCount != rhs.vertexCount) {
+        plan.reason = "sizes differ, nothing to check";
+    }
+    return plan;
+}
+
+auto Graph::degreeOrder(const bits::BitMatrix& adjacency) -> vector<size_t> {
+    size_t vertexCount = adjacency.getSize();
+    vector<size_t> degrees(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        degrees[vertex] = bits::count(adjacency[vertex]);
+    }
+
+    vector<size_t> order(vertexCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, std::greater{},
+                             [&](size_t vertex) { return degrees[vertex]; });
+    return order;
+}
+
+[[nodiscard]] auto Graph::estimateMaxClique() const -> clique::TreeEstimate {
+    clique::IgnoreTies quick{vertexCount};
+    return estimateCliqueSearch<clique::MutualAdjacency>(quick);
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::estimateCliqueSearch(Ties& quick) const -> clique::TreeEstimate {
+    localSearchCliques<Adjacency>(quick);
+    size_t known = quick.bestSize();
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<Adjacency>(adjacency);
+    return clique::estimateTreeSize(
+        adjacency, {.probes = ESTIMATE_PROBES,
+                    .seed = LOCAL_SEARCH_SEED,
+                    .target = Ties::KEEPS_TIES ? known : known + 1});
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::resolveAccuracy(AlgorithmAccuracy accuracy, CliqueEngine engine,
+                            vector<vector<size_t>>& incumbents) const
+    -> AlgorithmAccuracy {
+    if (accuracy != AlgorithmAccuracy::AUTO) {
+        return accuracy;
+    }
+
+    // The independent set search only gets the local search, for its time
+    // limit to fall back on
+    Ties quick{vertexCount};
+    std::optional<clique::TreeEstimate> estimate;
+    if (engine == CliqueEngine::COMPLEMENT) {
+        localSearchCliques<Adjacency>(quick);
+    } else {
+        estimate = estimateCliqueSearch<Adjacency>(quick);
+    }
+    if constexpr (Ties::KEEPS_TIES) {
+        incumbents = quick.getCliques();
+    } else {
+        incumbents = {quick.getBest()};
+    }
+    return !estimate || estimate->time <= exactBudget
+               ? AlgorithmAccuracy::EXACT
+               : AlgorithmAccuracy::APPROXIMATE;
+}
 
-            if (adjacencyMatrix[lhsRow][lhsCol] == 0 &&
-                rhs[rhsRow][rhsCol] == 0) {
-                adjacencyMatrixOfResultGraph[row][col] = 1;
+[[nodiscard]] auto Graph::maxClique(AlgorithmAccuracy accuracy,
+                                    size_t threadCount,
+                                    CliqueEngine engine) const
+    -> std::vector<size_t> {
+    return searchCliques<clique::MutualAdjacency, clique::IgnoreTies>(
+               accuracy, threadCount, engine)
+        .getBest();
+}
+
+[[nodiscard]] auto Graph::maxClique(const SearchCheckpoint& checkpoint) const
+    -> std::vector<size_t> {
+    clique::IgnoreTies ties{vertexCount};
+    checkpointedCliques<clique::MutualAdjacency>(ties, checkpoint,
+                                                 "max-clique");
+    return ties.getBest();
+}
+
+[[nodiscard]] auto Graph::maxClique(
+    const CliqueHint& hint, AlgorithmAccuracy accuracy, size_t threadCount,
+    CliqueEngine engine,
+    const std::function<void(const SearchPlan&)>& onPlan) const
+    -> std::vector<size_t> {
+    checkHint(hint);
+
+    // Symmetry only gets measured for whoever's watching, the search finds
+    // orbits on its own anyway
+    auto plan = planCliqueSearch<clique::MutualAdjacency, clique::IgnoreTies>(
+        "maxClique", accuracy, engine, threadCount, !hint.order.empty(),
+        onPlan ? SYMMETRY_SEARCH_ROUNDS : 0);
+    if (onPlan) {
+        onPlan(plan);
+    }
+    return searchCliques<clique::MutualAdjacency, clique::IgnoreTies>(
+               plan, threadCount, hint)
+        .getBest();
+}
+
+[[nodiscard]] auto Graph::certifiedMaxClique(size_t threadCount,
+                                             CliqueEngine engine) const
+    -> clique::CliqueCertificate {
+    auto clique = maxClique(AlgorithmAccuracy::EXACT, threadCount, engine);
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    return clique::certifyClique(adjacency, std::move(clique));
+}
+
+[[nodiscard]] auto Graph::verifyMaxClique(
+    const clique::CliqueCertificate& certificate) const -> bool {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    return clique::verifyCertificate(adjacency, certificate);
+}
+
+auto Graph::checkHint(const CliqueHint& hint) const -> void {
+    vector<bool> inClique(vertexCount);
+    for (size_t vertex : hint.clique) {
+        if (vertex >= vertexCount) {
+            throw invalid_argument{"Hint vertex " + std::to_string(vertex) +
+                                   " out of range"};
+        }
+        if (inClique[vertex]) {
+            throw invalid_argument{"Hint vertex " + std::to_string(vertex) +
+                                   " repeated"};
+        }
+        inClique[vertex] = true;
+    }
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    for (size_t vertex : hint.clique) {
+        for (size_t other : hint.clique) {
+            if (vertex != other && !bits::test(adjacency[vertex], other)) {
+                throw invalid_argument{
+                    "Hint isn't a clique, " + std::to_string(vertex) +
+                    " and " + std::to_string(other) + " aren't adjacent"};
             }
         }
     }
 
-    return Graph{std::move(adjacencyMatrixOfResultGraph)};
+    if (hint.order.empty()) {
+        return;
+    }
+    if (hint.order.size() != vertexCount) {
+        throw invalid_argument{"Hint order has " +
+                               std::to_string(hint.order.size()) +
+                               " vertices, the graph has " +
+                               std::to_string(vertexCount)};
+    }
+    vector<bool> ordered(vertexCount);
+    for (size_t vertex : hint.order) {
+        if (vertex >= vertexCount || ordered[vertex]) {
+            throw invalid_argument{"Hint order isn't a permutation"};
+        }
+        ordered[vertex] = true;
+    }
 }
 
-[[nodiscard]] auto Graph::maxClique(AlgorithmAccuracy accuracy) const
-    -> std::vector<size_t> {
-    std::vector<size_t> currentClique;
-    std::vector<std::vector<size_t>> maxCliques{{}};
-    size_t currentExecution = 0;
-    size_t maxExecutionLimit = ESTIMATE_MULTIPLIER * vertexCount * vertexCount;
+[[nodiscard]] auto Graph::allMaxCliques(AlgorithmAccuracy accuracy,
+                                        size_t threadCount) const
+    -> std::vector<std::vector<size_t>> {
+    return searchCliques<clique::MutualAdjacency, clique::KeepTies>(
+               accuracy, threadCount)
+        .getCliques();
+}
+
+[[nodiscard]] auto Graph::anytimeMaxClique(
+    const SearchBudget& budget,
+    const std::function<void(const std::vector<size_t>&)>& onImprovement,
+    const CliqueHint& hint) const -> AnytimeClique {
+    checkHint(hint);
+
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    if (budget.timeLimit) {
+        deadline = std::chrono::steady_clock::now() + *budget.timeLimit;
+    }
+
+    clique::Budget limits{
+        budget.nodeLimit.value_or(std::numeric_limits<size_t>::max()),
+        deadline};
+    clique::IgnoreTies ties{vertexCount};
+
+    // Straight into ties, the caller already knows about it
+    vector<size_t> hinted = hint.clique;
+    std::ranges::sort(hinted);
+    ties.record(hinted);
+
+    clique::ReportImprovements reporting{ties, onImprovement};
+    runCliqueSearch<clique::MutualAdjacency>(
+        reporting, limits, 1, hint.order,
+        cliqueOrbits<clique::MutualAdjacency>());
+
+    return {ties.getBest(), !limits.wasStopped(), limits.getNodeCount()};
+}
+
+[[nodiscard]] auto Graph::findCliqueOfSize(size_t size,
+                                           size_t threadCount) const
+    -> std::optional<vector<size_t>> {
+    if (size == 0) {
+        return vector<size_t>{};
+    }
+    if (size > vertexCount) {
+        return std::nullopt;
+    }
+
+    clique::Threshold threshold{size, vertexCount};
+    clique::Exact exact;
+    runCliqueSearch<clique::MutualAdjacency>(
+        threshold, exact, threadCount, {},
+        cliqueOrbits<clique::MutualAdjacency>());
+    return threshold.getWitness();
+}
+
+[[nodiscard]] auto Graph::hasCliqueOfSize(size_t size,
+                                          size_t threadCount) const -> bool {
+    return findCliqueOfSize(size, threadCount).has_value();
+}
+
+[[nodiscard]] auto Graph::topKCliques(size_t count, size_t threadCount) const
+    -> std::vector<std::vector<size_t>> {
+    if (count == 0) {
+        return {};
+    }
+    if (vertexCount == 0) {
+        // The parallel search never offers a clique that can't beat the
+        // bound, and here the only one is empty
+        return {{}};
+    }
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    clique::TopK topK{count, adjacency};
+    clique::Exact exact;
+    runCliqueSearch<clique::MutualAdjacency>(topK, exact, threadCount);
+    return topK.getCliques();
+}
+
+[[nodiscard]] auto Graph::maximalCliques() const
+    -> Generator<vector<size_t>> {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+
+    // Bron-Kerbosch on an explicit stack, row d has the candidates (P) and
+    // the already covered vertices (X) for a clique of d members
+    bits::BitMatrix candidates{vertexCount + 1, vertexCount};
+    bits::BitMatrix excluded{vertexCount + 1, vertexCount};
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(candidates[0], vertex);
+    }
+
+    // An excluded vertex adjacent to every candidate extends everything
+    // that's left in this branch, so none of it can be maximal
+    auto isDominated = [&](span<const Word> options, span<const Word> done) {
+        size_t optionCount = bits::count(options);
+        for (size_t vertex = bits::nextSet(done, 0); vertex < vertexCount;
+             vertex = bits::nextSet(done, vertex + 1)) {
+            if (bits::intersectCount(options, adjacency[vertex]) ==
+                optionCount) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    vector<size_t> members;
+    members.reserve(vertexCount);
+    for (;;) {
+        size_t depth = members.size();
+        auto options = candidates[depth];
+        auto done = excluded[depth];
+
+        // Backtracking leaves the last member in X, so this only triggers
+        // once per clique
+        if (bits::none(options) && bits::none(done)) {
+            co_yield members;
+        }
 
-    maxCliqueHelper(0, currentClique, maxCliques, accuracy, currentExecution,
-                    maxExecutionLimit, [&](int vertex, auto currentClique) {
-                        return all_of(currentClique, [&](int cliqueVertex) {
-                            return adjacencyMatrix[vertex][cliqueVertex] > 0 &&
-                                   adjacencyMatrix[cliqueVertex][vertex] > 0;
-                        });
-                    });
+        if (bits::none(options) || isDominated(options, done)) {
+            if (depth == 0) {
+                co_return;
+            }
+            members.pop_back();
+            continue;
+        }
+
+        size_t vertex = bits::nextSet(options, 0);
+        bits::reset(options, vertex);
+        bits::set(done, vertex);
+        members.push_back(vertex);
+        bits::intersect(options, adjacency[vertex], candidates[depth + 1]);
+        bits::intersect(done, adjacency[vertex], excluded[depth + 1]);
+    }
+}
+
+auto Graph::forEachMaximalClique(
+    const std::function<void(span<const size_t>)>& visit) const -> size_t {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    return clique::enumerateMaximalCliques(adjacency, visit);
+}
+
+[[nodiscard]] auto Graph::countCliques(size_t maxSize,
+                                       size_t threadCount) const
+    -> vector<clique::CliqueCounts> {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    return clique::countCliques(adjacencyLists(adjacency), maxSize,
+                                threadCount);
+}
+
+[[nodiscard]] auto Graph::countTriangles(size_t threadCount) const
+    -> clique::TriangleCounts {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+    return clique::countTriangles(adjacency, threadCount);
+}
+
+[[nodiscard]] auto Graph::maximumIndependentSet() const -> vector<size_t> {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::EitherAdjacency>(adjacency);
+    return clique::maximumIndependentSet(adjacencyLists(adjacency));
+}
 
-    return maxCliques[0];
+[[nodiscard]] auto Graph::minimumVertexCover() const -> vector<size_t> {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::EitherAdjacency>(adjacency);
+    return clique::minimumVertexCover(adjacency);
 }
 
-[[nodiscard]] auto Graph::modifiedMaxClique(AlgorithmAccuracy accuracy) const
+[[nodiscard]] auto Graph::cliquesOfSize(size_t size) const
+    -> Generator<vector<size_t>> {
+    vector<size_t> members;
+    if (size == 0) {
+        co_yield members;
+        co_return;
+    }
+    if (size > vertexCount) {
+        co_return;
+    }
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<clique::MutualAdjacency>(adjacency);
+
+    // Row d has the candidates for the d-th member
+    bits::BitMatrix candidates{size, vertexCount};
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(candidates[0], vertex);
+    }
+
+    members.reserve(size);
+    for (;;) {
+        size_t depth = members.size();
+        auto options = candidates[depth];
+        size_t vertex = bits::nextSet(options, 0);
+
+        // Out of options, or not enough of them left to get to size
+        if (vertex >= vertexCount || depth + bits::count(options) < size) {
+            if (depth == 0) {
+                co_return;
+            }
+            members.pop_back();
+            continue;
+        }
+
+        bits::reset(options, vertex);
+        members.push_back(vertex);
+        if (members.size() == size) {
+            co_yield members;
+            members.pop_back();
+        } else {
+            bits::intersect(options, adjacency[vertex], candidates[depth + 1]);
+        }
+    }
+}
+
+[[nodiscard]] auto Graph::modifiedMaxClique(AlgorithmAccuracy accuracy,
+                                            size_t threadCount,
+                                            CliqueEngine engine) const
+    -> std::vector<size_t> {
+    return modifiedMaxClique(planModifiedSearch("modifiedMaxClique", accuracy,
+                                                threadCount, engine, 0),
+                             threadCount);
+}
+
+[[nodiscard]] auto Graph::modifiedMaxClique(const SearchPlan& plan,
+                                            size_t threadCount) const
     -> std::vector<size_t> {
-    std::vector<size_t> currentClique;
-    std::vector<std::vector<size_t>> maxCliques{{}};
-    size_t currentExecution = 0;
-    size_t maxExecutionLimit = ESTIMATE_MULTIPLIER * vertexCount * vertexCount;
-
-    maxCliqueHelper(0, currentClique, maxCliques, accuracy, currentExecution,
-                    maxExecutionLimit, [&](int vertex, auto currentClique) {
-                        return all_of(currentClique, [&](int cliqueVertex) {
-                            return adjacencyMatrix[vertex][cliqueVertex] > 0 ||
-                                   adjacencyMatrix[cliqueVertex][vertex] > 0;
-                        });
-                    });
-
-    return *max_element(maxCliques, [this](const auto& lhs, const auto& rhs) {
-        auto lhsConnections = totalConnections(lhs);
-        auto rhsConnections = totalConnections(rhs);
-
-        return lhsConnections == rhsConnections
-                   ? edgeCount(lhs) < edgeCount(rhs)
-                   : lhsConnections < rhsConnections;
+    if (plan.storage == GraphStorage::DENSE) {
+        return clique::heaviestMaxClique(adjacencyMatrix);
+    }
+
+    // Otherwise every maximum clique gets collected, and the tie-break
+    // happens after
+    return heaviestClique(
+        searchCliques<clique::EitherAdjacency, clique::KeepTies>(plan,
+                                                                 threadCount)
+            .getCliques());
+}
+
+[[nodiscard]] auto Graph::modifiedMaxClique(
+    const SearchCheckpoint& checkpoint) const -> std::vector<size_t> {
+    clique::HeaviestTies ties{adjacencyMatrix};
+    checkpointedCliques<clique::EitherAdjacency>(ties, checkpoint,
+                                                 "modified-max-clique");
+    return ties.getBest();
+}
+
+auto Graph::heaviestClique(const vector<vector<size_t>>& maxCliques) const
+    -> vector<size_t> {
+    // Each one scored once, instead of twice per comparison
+    std::vector<std::pair<size_t, size_t>> scores;
+    scores.reserve(maxCliques.size());
+    for (const auto& clique : maxCliques) {
+        scores.emplace_back(totalConnections(clique), edgeCount(clique));
+    }
+
+    return maxCliques[static_cast<size_t>(max_element(scores) -
+                                          scores.begin())];
+}
+
+template <typename Adjacency, typename Ties>
+[[nodiscard]] auto Graph::searchCliques(AlgorithmAccuracy accuracy,
+                                        size_t threadCount,
+                                        CliqueEngine engine,
+                                        const CliqueHint& hint) const -> Ties {
+    return searchCliques<Adjacency, Ties>(
+        planCliqueSearch<Adjacency, Ties>("", accuracy, engine, threadCount,
+                                          !hint.order.empty(), 0),
+        threadCount, hint);
+}
+
+template <typename Adjacency, typename Ties>
+[[nodiscard]] auto Graph::searchCliques(const SearchPlan& plan,
+                                        size_t threadCount,
+                                        const CliqueHint& hint) const -> Ties {
+    Ties ties{vertexCount};
+
+    // Everything after this only records what's at least as good. The
+    // empty clique would come up twice, the search records it too.
+    if (!hint.clique.empty()) {
+        vector<size_t> hinted = hint.clique;
+        std::ranges::sort(hinted);
+        ties.record(hinted);
+    }
+
+    if (!plan.engine) {
+        // The same local search already ran for the estimate, if there was
+        // one
+        if (plan.incumbents.empty()) {
+            localSearchCliques<Adjacency>(ties);
+        }
+        for (const auto& incumbent : plan.incumbents) {
+            ties.record(incumbent);
+        }
+        if constexpr (Ties::KEEPS_TIES) {
+            ties.sortUnique();
+        }
+        return ties;
+    }
+
+    switch (*plan.engine) {
+        // The planner never leaves it at AUTO
+        case CliqueEngine::AUTO:
+        case CliqueEngine::BRANCH_AND_BOUND: {
+            vector<size_t> order = hint.order;
+            if (plan.order == VertexOrder::DEGREE) {
+                bits::BitMatrix adjacency{vertexCount};
+                cliqueAdjacency<Adjacency>(adjacency);
+                order = degreeOrder(adjacency);
+            }
+
+            clique::Exact exact;
+            vector<size_t> orbits;
+            if constexpr (!Ties::KEEPS_TIES) {
+                orbits = cliqueOrbits<Adjacency>();
+            }
+            runCliqueSearch<Adjacency>(ties, exact, threadCount, order,
+                                       orbits);
+            break;
+        }
+        case CliqueEngine::RUSSIAN_DOLL: {
+            bits::BitMatrix adjacency{vertexCount};
+            cliqueAdjacency<Adjacency>(adjacency);
+            if constexpr (std::is_same_v<Ties, clique::IgnoreTies>) {
+                // A race of one, only so it prunes against the hint
+                clique::Race<Ties> race{ties};
+                clique::russianDollSearch(adjacency, race);
+            } else {
+                ties.record(clique::russianDollSearch(adjacency));
+            }
+            break;
+        }
+        case CliqueEngine::COMPLEMENT:
+            // Only there to fall back on if the time's up
+            if (plan.timeLimit) {
+                for (const auto& incumbent : plan.incumbents) {
+                    ties.record(incumbent);
+                }
+            }
+            complementCliques<Adjacency>(ties, 1, plan.timeLimit);
+            break;
+        case CliqueEngine::PORTFOLIO:
+            portfolioCliques<Adjacency>(ties, threadCount, hint.order);
+            break;
+    }
+
+    // The hint and a renumbered search can both add ties out of order
+    if constexpr (Ties::KEEPS_TIES) {
+        if (!hint.clique.empty() || !hint.order.empty() ||
+            plan.order != VertexOrder::NATURAL) {
+            ties.sortUnique();
+        }
+    }
+
+    return ties;
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::localSearchCliques(Ties& ties) const -> void {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<Adjacency>(adjacency);
+
+    // Same as the exact search, the empty clique counts
+    std::vector<size_t> sorted;
+    sorted.reserve(vertexCount);
+    ties.record(sorted);
+
+    clique::localSearch(
+        adjacency,
+        {.maxSteps = std::max(LOCAL_SEARCH_STEPS_PER_VERTEX * vertexCount,
+                              LOCAL_SEARCH_MIN_STEPS),
+         .seed = LOCAL_SEARCH_SEED},
+        [&](span<const size_t> found) {
+            if (!ties.isWorthExploring(found.size())) {
+                return;
+            }
+            sorted.assign(found.begin(), found.end());
+            std::ranges::sort(sorted);
+            ties.record(sorted);
+        });
+
+    // The search can end up at the same clique over and over
+    if constexpr (Ties::KEEPS_TIES) {
+        ties.sortUnique();
+    }
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::complementCliques(
+    Ties& ties, double maxDensity,
+    std::optional<std::chrono::nanoseconds> timeLimit) const -> bool {
+    auto lists = complementLists<Adjacency>(maxDensity);
+    if (!lists) {
+        return false;
+    }
+
+    if constexpr (std::is_same_v<Ties, clique::IgnoreTies>) {
+        // A race of one, only so it prunes against what's there already,
+        // and so a watcher can end it once the time's up
+        clique::Race<Ties> race{ties};
+        if (!timeLimit) {
+            clique::maximumIndependentSet(*lists, race);
+            return true;
+        }
+
+        std::mutex mutex;
+        std::condition_variable searched;
+        bool done = false;
+        std::thread watcher{[&] {
+            std::unique_lock lock{mutex};
+            searched.wait_for(lock, *timeLimit, [&] { return done; });
+            race.finish();
+        }};
+        clique::maximumIndependentSet(*lists, race);
+        {
+            std::lock_guard lock{mutex};
+            done = true;
+        }
+        searched.notify_one();
+        watcher.join();
+    } else {
+        ties.record(clique::maximumIndependentSet(*lists));
+    }
+    return true;
+}
+
+template <typename Adjacency>
+auto Graph::complementLists(double maxDensity) const
+    -> std::optional<vector<vector<size_t>>> {
+    bits::BitMatrix complement{vertexCount};
+    cliqueAdjacency<Adjacency>(complement);
+
+    std::vector<Word> everything(complement.getStride());
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(everything, vertex);
+    }
+
+    size_t degreeSum = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        auto row = complement[vertex];
+        bits::andNot(everything, row, row);
+        bits::reset(row, vertex);
+        degreeSum += bits::count(row);
+    }
+
+    // Both directions of every pair, over all of them
+    if (static_cast<double>(degreeSum) >
+        maxDensity * static_cast<double>(vertexCount * (vertexCount - 1))) {
+        return std::nullopt;
+    }
+
+    return adjacencyLists(complement);
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::portfolioCliques(Ties& ties, size_t threadCount,
+                             const vector<size_t>& order) const -> void {
+    clique::Race<Ties> race{ties};
+
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<Adjacency>(adjacency);
+
+    auto byDegree = degreeOrder(adjacency);
+
+    vector<size_t> orbits;
+    if constexpr (!Ties::KEEPS_TIES) {
+        orbits = cliqueOrbits<Adjacency>();
+    }
+
+    // Whoever gets to the end first finishes the race, the rest see that
+    // on their next node and drop out
+    vector<std::thread> entrants;
+    entrants.emplace_back([&] {
+        runCliqueSearch<Adjacency>(race, race, 1, byDegree, orbits);
+        race.finish();
+    });
+    if constexpr (std::is_same_v<Ties, clique::IgnoreTies>) {
+        entrants.emplace_back([&] {
+            clique::russianDollSearch(adjacency, race);
+            race.finish();
+        });
+        entrants.emplace_back([&] {
+            // Too dense a complement doesn't enter at all, so it can't
+            // finish the race either
+            if (auto lists = complementLists<Adjacency>(
+                    PORTFOLIO_COMPLEMENT_DENSITY)) {
+                clique::maximumIndependentSet(*lists, race);
+                race.finish();
+            }
+        });
+    }
+
+    // This thread is an entrant too, in the caller's order, along with
+    // however many more threads the caller asked for
+    runCliqueSearch<Adjacency>(race, race, threadCount, order, orbits);
+    race.finish();
+    for (auto& entrant : entrants) {
+        entrant.join();
+    }
+
+    // Every branch and bound finds each tie on its own
+    if constexpr (Ties::KEEPS_TIES) {
+        ties.sortUnique();
+    }
+}
+
+template <typename Adjacency, typename Ties>
+auto Graph::checkpointedCliques(Ties& ties, const SearchCheckpoint& checkpoint,
+                                const string& kind) const -> void {
+    bits::BitMatrix original{vertexCount};
+    cliqueAdjacency<Adjacency>(original);
+
+    clique::SearchState state{
+        kind, vertexCount, clique::fingerprint(original), {}, {}};
+    if (checkpoint.resumePath.empty()) {
+        vector<size_t> everything(vertexCount);
+        std::iota(everything.begin(), everything.end(), 0);
+        state.frontier.push_back({{}, std::move(everything)});
+    } else {
+        auto saved = clique::loadState(checkpoint.resumePath);
+        if (saved.kind != state.kind || saved.vertexCount != vertexCount ||
+            saved.fingerprint != state.fingerprint) {
+            throw invalid_argument("Search state is from a different search");
+        }
+
+        // loadState only checks the vertices are in range, and whatever an
+        // edited or corrupt file gets wrong beyond that would end up in the
+        // answer. Rows are loopless, so a repeated vertex fails too
+        auto extendsAll = [&](size_t vertex, span<const size_t> clique) {
+            return std::ranges::all_of(clique, [&](size_t member) {
+                return bits::test(original[member], vertex);
+            });
+        };
+        auto isClique = [&](const vector<size_t>& clique) {
+            for (size_t i = 0; i < clique.size(); ++i) {
+                if (!extendsAll(clique[i], span{clique}.first(i))) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        for (const auto& incumbent : saved.incumbents) {
+            if (!isClique(incumbent)) {
+                throw invalid_argument("Search state has an incumbent that "
+                                       "isn't a clique");
+            }
+        }
+        for (const auto& task : saved.frontier) {
+            if (!isClique(task.clique) ||
+                !std::ranges::all_of(task.candidates, [&](size_t vertex) {
+                    return extendsAll(vertex, task.clique);
+                })) {
+                throw invalid_argument("Search state has a task whose "
+                                       "candidates don't extend its clique");
+            }
+        }
+
+        for (const auto& incumbent : saved.incumbents) {
+            ties.record(incumbent);
+        }
+        state.frontier = std::move(saved.frontier);
+    }
+
+    auto save = [&] {
+        if (checkpoint.savePath.empty()) {
+            return;
+        }
+
+        if constexpr (requires { ties.getBest(); }) {
+            state.incumbents = {ties.getBest()};
+        } else {
+            state.incumbents = ties.getCliques();
+        }
+        clique::saveState(state, checkpoint.savePath);
+    };
+
+    bits::withFixedWords(vertexCount, [&]<size_t Words>(
+                                          std::integral_constant<size_t,
+                                                                 Words>) {
+        constexpr size_t ROWS = Words * bits::WORD_BITS;
+        bits::BitRows<Words, ROWS> adjacency{vertexCount, vertexCount};
+        cliqueAdjacency<Adjacency>(adjacency);
+
+        bits::BitRows<Words, ROWS + 3> candidateStack{vertexCount + 3,
+                                                      vertexCount};
+        vector<size_t> currentClique;
+        currentClique.reserve(vertexCount);
+
+        auto toVertices = [&](const auto& row) {
+            vector<size_t> vertices;
+            for (size_t vertex = bits::nextSet(row, 0); vertex < vertexCount;
+                 vertex = bits::nextSet(row, vertex + 1)) {
+                vertices.push_back(vertex);
+            }
+            return vertices;
+        };
+
+        while (!state.frontier.empty()) {
+            auto deadline = std::chrono::steady_clock::now() +
+                            checkpoint.interval;
+            vector<clique::FrontierTask> unfinished;
+            bool interrupted = false;
+            while (!interrupted && !state.frontier.empty()) {
+                auto task = std::move(state.frontier.back());
+                state.frontier.pop_back();
+
+                size_t depth = task.clique.size();
+                auto&& candidates = candidateStack[depth];
+                std::ranges::fill(candidates, Word{0});
+                for (size_t vertex : task.candidates) {
+                    bits::set(candidates, vertex);
+                }
+                currentClique = std::move(task.clique);
+
+                // Each level from the task's down to the one interrupted
+                // has the rest of its candidates still to go through
+                clique::Interruptible interruptible{
+                    ties,
+                    clique::Budget{std::numeric_limits<size_t>::max(),
+                                   deadline},
+                    [&] {
+                        for (size_t level = depth;
+                             level <= currentClique.size(); ++level) {
+                            unfinished.push_back(
+                                {{currentClique.begin(),
+                                  currentClique.begin() +
+                                      static_cast<std::ptrdiff_t>(level)},
+                                 toVertices(candidateStack[level])});
+                        }
+                    }};
+                maxCliqueHelper(adjacency, candidateStack, currentClique,
+                                interruptible, interruptible);
+                interrupted = interruptible.wasStopped();
+            }
+
+            // The deepest level goes on top, the next one to come off
+            std::ranges::move(unfinished, std::back_inserter(state.frontier));
+            save();
+        }
+    });
+
+    // Resumed ties and re-entered nodes can come up twice
+    if constexpr (requires { ties.sortUnique(); }) {
+        ties.sortUnique();
+    }
+}
+
+template <typename Adjacency, typename Ties, typename Accuracy>
+auto Graph::runCliqueSearch(Ties& ties, Accuracy& accuracy,
+                            size_t threadCount, const vector<size_t>& order,
+                            const vector<size_t>& orbits) const -> void {
+    // Whether each vertex, renumbered, is the first of its orbit
+    vector<bool> roots;
+    if (!orbits.empty()) {
+        roots.resize(vertexCount);
+        vector<bool> seen(vertexCount);
+        for (size_t position = 0; position < vertexCount; ++position) {
+            size_t orbit = orbits[order.empty() ? position : order[position]];
+            roots[position] = !seen[orbit];
+            seen[orbit] = true;
+        }
+    }
+
+    // Graphs of up to 256 vertices get their own instantiation, where every
+    // row is a std::array on the stack and loop bounds are constants
+    bits::withFixedWords(vertexCount, [&]<size_t Words>(
+                                          std::integral_constant<size_t,
+                                                                 Words>) {
+        constexpr size_t ROWS = Words * bits::WORD_BITS;
+        bits::BitRows<Words, ROWS> adjacency{vertexCount, vertexCount};
+        cliqueAdjacency<Adjacency>(adjacency);
+
+        // One row per depth, plus two for coloringBound to scribble on
+        bits::BitRows<Words, ROWS + 3> candidateStack{vertexCount + 3,
+                                                      vertexCount};
+
+        auto search = [&](const bits::BitRows<Words, ROWS>& rows,
+                          auto& into) {
+            if constexpr (clique::Shareable<Accuracy>) {
+                if (threadCount > 1) {
+                    searchCliquesInParallel<Words>(rows, into, accuracy,
+                                                   threadCount, roots);
+                    return;
+                }
+            }
+
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                bits::set(candidateStack[0], vertex);
+            }
+
+            std::vector<size_t> currentClique;
+            currentClique.reserve(vertexCount);
+            if (roots.empty()) {
+                maxCliqueHelper(rows, candidateStack, currentClique, into,
+                                accuracy);
+            } else {
+                branchOnOrbits(rows, candidateStack, currentClique, into,
+                               accuracy, roots);
+            }
+        };
+
+        if (order.empty()) {
+            search(adjacency, ties);
+            return;
+        }
+
+        vector<size_t> positions(vertexCount);
+        for (size_t position = 0; position < vertexCount; ++position) {
+            positions[order[position]] = position;
+        }
+
+        bits::BitRows<Words, ROWS> renumberedAdjacency{vertexCount,
+                                                       vertexCount};
+        for (size_t position = 0; position < vertexCount; ++position) {
+            auto row = adjacency[order[position]];
+            for (size_t other = bits::nextSet(row, 0); other < vertexCount;
+                 other = bits::nextSet(row, other + 1)) {
+                bits::set(renumberedAdjacency[position], positions[other]);
+            }
+        }
+
+        clique::Renumbered<Ties> renumbered{ties, order};
+        search(renumberedAdjacency, renumbered);
+    });
+}
+
+template <size_t Words, typename Accuracy, typename Ties>
+auto Graph::searchCliquesInParallel(
+    const bits::BitRows<Words, Words * bits::WORD_BITS>& adjacency, Ties& ties,
+    Accuracy& accuracy, size_t threadCount, const vector<bool>& roots) const
+    -> void {
+    constexpr size_t ROWS = Words * bits::WORD_BITS;
+
+    // A node of the search tree: the clique so far and what can extend it
+    struct Task {
+        std::vector<size_t> clique;
+        std::vector<Word> candidates;
+    };
+
+    // A race is thread safe already, and wrapping it would hide what the
+    // other entrants find
+    clique::SharedTies<Ties> wrapped{ties};
+    auto& sharedTies = [&]() -> auto& {
+        if constexpr (clique::Shareable<Ties>) {
+            return ties;
+        } else {
+            return wrapped;
+        }
+    }();
+    WorkStealingPool<Task> pool{threadCount};
+
+    Task root{{}, std::vector<Word>(adjacency.getStride())};
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        bits::set(root.candidates, vertex);
+    }
+    pool.push(0, std::move(root));
+
+    pool.run([&](size_t worker) {
+        return [&, worker,
+                candidateStack = bits::BitRows<Words, ROWS + 3>{
+                    vertexCount + 3, vertexCount},
+                currentClique = std::vector<size_t>{}](Task&& task) mutable {
+            if (accuracy.exhausted()) {
+                return;
+            }
+
+            size_t depth = task.clique.size();
+            if (depth >= PARALLEL_SPLIT_DEPTH) {
+                // Deep enough, the rest of this subtree stays on this thread
+                currentClique.assign(task.clique.begin(), task.clique.end());
+                std::ranges::copy(task.candidates,
+                                  candidateStack[depth].begin());
+                maxCliqueHelper(adjacency, candidateStack, currentClique,
+                                sharedTies, accuracy);
+                return;
+            }
+
+            // Same branching as maxCliqueHelper, except every child becomes
+            // a task that whoever's idle can steal
+            sharedTies.record(task.clique);
+            span<Word> candidates{task.candidates};
+            for (size_t vertex = bits::nextSet(candidates, 0);
+                 vertex < vertexCount;
+                 vertex = bits::nextSet(candidates, vertex + 1)) {
+                bits::reset(candidates, vertex);
+                if (!sharedTies.isWorthExploring(depth + 1 +
+                                                 bits::count(candidates))) {
+                    break;
+                }
+                if (depth == 0 && !roots.empty() && !roots[vertex]) {
+                    continue;
+                }
+
+                Task child{task.clique, std::vector<Word>(candidates.size())};
+                child.clique.push_back(vertex);
+                bits::intersect(candidates, adjacency[vertex],
+                                child.candidates);
+                pool.push(worker, std::move(child));
+            }
+        };
     });
+
+    // A race gets sorted once it's over, by whoever ran it
+    if constexpr (Ties::KEEPS_TIES && std::is_same_v<Accuracy, clique::Exact>) {
+        ties.sortUnique();
+    }
+}
+
+template <typename Adjacency>
+auto Graph::cliqueOrbits() const -> vector<size_t> {
+    bits::BitMatrix adjacency{vertexCount};
+    cliqueAdjacency<Adjacency>(adjacency);
+    return clique::vertexOrbits(adjacency, SYMMETRY_SEARCH_ROUNDS);
+}
+
+template <typename Accuracy, typename Ties>
+auto Graph::branchOnOrbits(const auto& adjacency, auto& candidateStack,
+                           std::vector<size_t>& currentClique, Ties& ties,
+                           Accuracy& accuracy,
+                           const std::vector<bool>& roots) const -> void {
+    ties.record(currentClique);
+
+    auto&& candidates = candidateStack[0];
+    if (bits::none(candidates) || accuracy.exhausted()) {
+        return;
+    }
+
+    auto&& nextCandidates = candidateStack[1];
+    for (size_t vertex = bits::nextSet(candidates, 0); vertex < vertexCount;
+         vertex = bits::nextSet(candidates, vertex + 1)) {
+        bits::reset(candidates, vertex);
+        if (!ties.isWorthExploring(1 + bits::count(candidates))) {
+            break;
+        }
+
+        // Its cliques have copies through an earlier vertex of its orbit
+        if (!roots[vertex]) {
+            continue;
+        }
+
+        bits::intersect(candidates, adjacency[vertex], nextCandidates);
+        currentClique.push_back(vertex);
+        maxCliqueHelper(adjacency, candidateStack, currentClique, ties,
+                        accuracy);
+        currentClique.pop_back();
+    }
 }
 
-auto Graph::maxCliqueHelper(size_t currentVertex,
-                            std::vector<size_t>& currentClique,
-                            std::vector<std::vector<size_t>>& maxCliques,
-                            AlgorithmAccuracy accuracy,
-                            size_t& currentExecution, size_t executionLimit,
-                            auto adjacencyFunction) const -> void {
-    if (currentClique.size() > maxCliques[0].size()) {
-        maxCliques.clear();
-        maxCliques = {std::vector<size_t>(currentClique)};
-    } else if (currentClique.size() == maxCliques[0].size()) {
-        maxCliques.push_back(currentClique);
+template <typename Accuracy, typename Ties>
+auto Graph::maxCliqueHelper(const auto& adjacency, auto& candidateStack,
+                            std::vector<size_t>& currentClique, Ties& ties,
+                            Accuracy& accuracy) const -> void {
+    ties.record(currentClique);
+
+    size_t depth = currentClique.size();
+    auto&& candidates = candidateStack[depth];
+    if (bits::none(candidates)) {
+        return;
     }
 
-    if (currentVertex == vertexCount) {
+    if (!ties.isWorthExploring(depth + bits::count(candidates))) {
         return;
     }
 
-    if (accuracy == AlgorithmAccuracy::APPROXIMATE) {
-        if (++currentExecution >= executionLimit) {
+    // Nothing in here could be recorded, however the bound stands, and
+    // this is cheaper than coloring
+    if constexpr (clique::MaximalOnly<Ties>) {
+        if (clique::isDominatedBranch(adjacency, currentClique, candidates,
+                                      candidateStack[vertexCount + 1])) {
             return;
         }
     }
 
-    for (size_t i = currentVertex; i < vertexCount; ++i) {
-        if (adjacencyFunction(i, currentClique)) {
-            currentClique.push_back(i);
-            maxCliqueHelper(i + 1, currentClique, maxCliques, accuracy,
-                            currentExecution, executionLimit,
-                            adjacencyFunction);
-            currentClique.pop_back();
+    if (!ties.isWorthExploring(
+            depth + clique::coloringBound(adjacency, candidates,
+                                          candidateStack[vertexCount + 1],
+                                          candidateStack[vertexCount + 2]))) {
+        return;
+    }
+
+    if (accuracy.exhausted()) {
+        return;
+    }
+
+    auto&& nextCandidates = candidateStack[depth + 1];
+    for (size_t vertex = bits::nextSet(candidates, 0); vertex < vertexCount;
+         vertex = bits::nextSet(candidates, vertex + 1)) {
+        // Later branches only get what's left after this vertex
+        bits::reset(candidates, vertex);
+        if (!ties.isWorthExploring(depth + 1 + bits::count(candidates))) {
+            break;
         }
+
+        bits::intersect(candidates, adjacency[vertex], nextCandidates);
+        currentClique.push_back(vertex);
+        maxCliqueHelper(adjacency, candidateStack, currentClique, ties,
+                        accuracy);
+        currentClique.pop_back();
+    }
+}
+
+[[nodiscard]] auto Graph::maxSubgraph(
+    const Graph& rhs, AlgorithmAccuracy accuracy, size_t threadCount,
+    CliqueEngine engine, const std::function<void(const SearchPlan&)>& onPlan)
+    -> Graph {
+    Graph modProd = modularProduct(rhs);
+    modProd.setExactBudget(exactBudget);
+
+    // Same as maxClique, symmetry only matters to whoever's watching
+    auto plan = modProd.planModifiedSearch(
+        "maxSubgraph", accuracy, threadCount, engine,
+        onPlan ? SYMMETRY_SEARCH_ROUNDS : 0);
+    if (onPlan) {
+        onPlan(plan);
     }
+    return commonSubgraph(rhs, modProd.modifiedMaxClique(plan, threadCount));
 }
 
 [[nodiscard]] auto Graph::maxSubgraph(const Graph& rhs,
-                                      AlgorithmAccuracy accuracy) -> Graph {
+                                      const SearchCheckpoint& checkpoint)
+    -> Graph {
     Graph modProd = modularProduct(rhs);
-    std::vector<size_t> maxClique = modProd.modifiedMaxClique(accuracy);
+    return commonSubgraph(rhs, modProd.modifiedMaxClique(checkpoint));
+}
+
+auto Graph::commonSubgraph(const Graph& rhs,
+                           const vector<size_t>& productClique) const
+    -> Graph {
+    const auto& maxClique = productClique;
     size_t maxCliqueSize = maxClique.size();
 
     std::vector<size_t> lhsVerts(maxCliqueSize);
@@ -358,9 +1798,10 @@ auto Graph::maxCliqueHelper(size_t currentVertex,
     return Graph(std::move(maxCliqueGraph));
 }
 
-[[nodiscard]] auto Graph::maxCliqueGraph(AlgorithmAccuracy accuracy) const
-    -> Graph {
-    auto maxCliqueVertices = maxClique(accuracy);
+[[nodiscard]] auto Graph::maxCliqueGraph(AlgorithmAccuracy accuracy,
+                                         size_t threadCount,
+                                         CliqueEngine engine) const -> Graph {
+    auto maxCliqueVertices = maxClique(accuracy, threadCount, engine);
 
 #ifdef DEBUG
     for (auto& vertex : maxCliqueVertices) {
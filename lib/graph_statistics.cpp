@@ -0,0 +1,64 @@
+/**
+ * @file graph_statistics.cpp
+ * @brief Graph statistics implementation
+ */
+#include "graph_statistics.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "maximal_cliques.hpp"
+#include "symmetry.hpp"
+
+using std::vector;
+
+namespace clique {
+
+auto measureStatistics(const bits::BitMatrix& adjacency, size_t symmetryRounds)
+    -> GraphStatistics {
+    size_t vertexCount = adjacency.getSize();
+    GraphStatistics statistics{vertexCount, 0, 0, 0, 0, 0, false};
+
+    size_t degreeSum = 0;
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        size_t degree = bits::count(adjacency[vertex]);
+        degreeSum += degree;
+        statistics.maxDegree = std::max(statistics.maxDegree, degree);
+    }
+    statistics.edgeCount = degreeSum / 2;
+
+    if (vertexCount > 1) {
+        statistics.density =
+            static_cast<double>(degreeSum) /
+            static_cast<double>(vertexCount * (vertexCount - 1));
+        statistics.complementDensity = 1 - statistics.density;
+    }
+
+    // Each vertex's neighbours later in the order, at most the degeneracy
+    // and exactly it for some vertex
+    auto order = degeneracyOrder(adjacency);
+    vector<size_t> positions(vertexCount);
+    for (size_t position = 0; position < vertexCount; ++position) {
+        positions[order[position]] = position;
+    }
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        size_t later = 0;
+        auto row = adjacency[vertex];
+        for (size_t other = bits::nextSet(row, 0); other < vertexCount;
+             other = bits::nextSet(row, other + 1)) {
+            later += static_cast<size_t>(positions[other] > positions[vertex]);
+        }
+        statistics.degeneracy = std::max(statistics.degeneracy, later);
+    }
+
+    if (symmetryRounds > 0) {
+        auto orbits = vertexOrbits(adjacency, symmetryRounds);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            statistics.symmetric |= orbits[vertex] != vertex;
+        }
+    }
+
+    return statistics;
+}
+
+}  // namespace clique
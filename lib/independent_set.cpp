@@ -0,0 +1,729 @@
+/**
+ * @file independent_set.cpp
+ * @brief Branch-and-reduce maximum independent set implementation
+ */
+#include "independent_set.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <ranges>
+#include <span>
+#include <utility>
+
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+// A vertex standing in for a few others, undone when lifting a solution back
+// to the original graph
+struct Fold {
+    // The merged vertex, which kept the id of one of them
+    size_t vertex;
+
+    // What goes in instead when the merged vertex is in: two of them (the
+    // rest NONE) for a degree 2 fold, three for a twin fold
+    std::array<size_t, 3> parts;
+
+    // For twin folds, the twin that goes in along with vertex when the
+    // merged vertex isn't in. NONE for degree 2 folds, where it's just vertex.
+    size_t twin;
+};
+
+// What's left of the graph, and how it got there. Adjacency lists can hold
+// dead vertices, degrees only count live ones.
+struct Kernel {
+    vector<vector<size_t>> adjacency;
+    vector<size_t> degrees;
+    vector<bool> alive;
+    size_t aliveCount{0};
+
+    vector<size_t> included;
+    vector<Fold> folds;
+
+    // How much bigger the solution gets once the folds are undone
+    size_t offset{0};
+};
+
+class BranchAndReduce {
+   private:
+    size_t vertexCount;
+    vector<size_t> best;
+
+    // Only solutions bigger than this are of any use to whoever asked
+    size_t mustBeat{0};
+
+    // The race this is part of, if any. Only a search over the whole graph
+    // shares its solutions there, the ones on components just stop with it.
+    Race<IgnoreTies>* race;
+    bool isWholeGraph{false};
+
+    // Stamped marks, so a set can be cleared by taking a new stamp
+    vector<size_t> marks;
+    size_t stamp{0};
+
+    // Hopcroft-Karp on the bipartite double cover, for the LP
+    vector<size_t> leftPartner;
+    vector<size_t> rightPartner;
+    vector<size_t> distances;
+    vector<bool> reachedLeft;
+    vector<bool> reachedRight;
+
+    // Where each vertex of a component goes, when solving it on its own
+    vector<size_t> localIds;
+
+    // The live neighbours of a vertex, dropping the dead ones for good
+    static auto live(Kernel& kernel, size_t vertex) -> vector<size_t>& {
+        auto& list = kernel.adjacency[vertex];
+        if (list.size() != kernel.degrees[vertex]) {
+            std::erase_if(list,
+                          [&](size_t other) { return !kernel.alive[other]; });
+        }
+        return list;
+    }
+
+    static auto isAdjacent(Kernel& kernel, size_t lhs, size_t rhs) -> bool {
+        if (kernel.degrees[lhs] > kernel.degrees[rhs]) {
+            std::swap(lhs, rhs);
+        }
+        const auto& list = live(kernel, lhs);
+        return std::ranges::find(list, rhs) != list.end();
+    }
+
+    static auto remove(Kernel& kernel, size_t vertex) -> void {
+        kernel.alive[vertex] = false;
+        --kernel.aliveCount;
+        for (size_t other : kernel.adjacency[vertex]) {
+            if (kernel.alive[other]) {
+                --kernel.degrees[other];
+            }
+        }
+    }
+
+    static auto include(Kernel& kernel, size_t vertex) -> void {
+        kernel.included.push_back(vertex);
+        ++kernel.offset;
+        remove(kernel, vertex);
+        for (size_t other : kernel.adjacency[vertex]) {
+            if (kernel.alive[other]) {
+                remove(kernel, other);
+            }
+        }
+    }
+
+    // Replaces vertex's neighbourhood with that of the removed ones, minus
+    // all of them
+    auto merge(Kernel& kernel, size_t vertex, std::span<const size_t> removed)
+        -> void {
+        size_t mark = ++stamp;
+        marks[vertex] = mark;
+        for (size_t other : removed) {
+            marks[other] = mark;
+        }
+
+        vector<size_t> merged;
+        for (size_t other : removed) {
+            for (size_t neighbour : live(kernel, other)) {
+                if (marks[neighbour] != mark) {
+                    marks[neighbour] = mark;
+                    merged.push_back(neighbour);
+                }
+            }
+        }
+
+        for (size_t other : removed) {
+            if (kernel.alive[other]) {
+                remove(kernel, other);
+            }
+        }
+        for (size_t neighbour : merged) {
+            kernel.adjacency[neighbour].push_back(vertex);
+            ++kernel.degrees[neighbour];
+        }
+        kernel.degrees[vertex] = merged.size();
+        kernel.adjacency[vertex] = std::move(merged);
+    }
+
+    // Degree 0, 1 and 2 rules, for everything in the queue and whoever
+    // they affect
+    auto reduceDegrees(Kernel& kernel, vector<size_t>& queue) -> void {
+        auto requeue = [&](size_t removed) {
+            for (size_t other : kernel.adjacency[removed]) {
+                if (kernel.alive[other]) {
+                    queue.push_back(other);
+                }
+            }
+        };
+
+        while (!queue.empty()) {
+            size_t vertex = queue.back();
+            queue.pop_back();
+            if (!kernel.alive[vertex] || kernel.degrees[vertex] > 2) {
+                continue;
+            }
+
+            auto& list = live(kernel, vertex);
+            if (list.empty()) {
+                include(kernel, vertex);
+            } else if (list.size() == 1) {
+                // The neighbour can't do anything the leaf can't
+                size_t neighbour = list.front();
+                include(kernel, vertex);
+                requeue(neighbour);
+            } else if (size_t first = list[0], second = list[1];
+                       isAdjacent(kernel, first, second)) {
+                // Same goes for a triangle
+                include(kernel, vertex);
+                requeue(first);
+                requeue(second);
+            } else {
+                // Either vertex is in, or both neighbours are, which the
+                // merged vertex stands for
+                merge(kernel, vertex, std::array{first, second});
+                kernel.folds.push_back({vertex, {first, second, NONE}, NONE});
+                ++kernel.offset;
+                queue.push_back(vertex);
+                requeue(vertex);
+            }
+        }
+    }
+
+    // If N[u] is inside N[v] for a neighbour u, any solution with v can
+    // swap it for u
+    auto reduceDomination(Kernel& kernel) -> bool {
+        bool changed = false;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (!kernel.alive[vertex]) {
+                continue;
+            }
+
+            size_t mark = ++stamp;
+            marks[vertex] = mark;
+            auto& list = live(kernel, vertex);
+            for (size_t other : list) {
+                marks[other] = mark;
+            }
+
+            bool isDominated = std::ranges::any_of(list, [&](size_t other) {
+                return kernel.degrees[other] <= kernel.degrees[vertex] &&
+                       std::ranges::all_of(
+                           live(kernel, other),
+                           [&](size_t next) { return marks[next] == mark; });
+            });
+            if (isDominated) {
+                remove(kernel, vertex);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    // Two degree 3 vertices with the same neighbours: both go in if the
+    // neighbours have an edge, otherwise it's both of them or all three
+    // neighbours, so the five fold into one
+    auto reduceTwins(Kernel& kernel) -> bool {
+        std::map<std::array<size_t, 3>, size_t> seen;
+        bool changed = false;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (!kernel.alive[vertex] || kernel.degrees[vertex] != 3) {
+                continue;
+            }
+
+            auto& list = live(kernel, vertex);
+            std::array<size_t, 3> neighbours{list[0], list[1], list[2]};
+            std::ranges::sort(neighbours);
+            auto [found, isNew] = seen.try_emplace(neighbours, vertex);
+            if (isNew) {
+                continue;
+            }
+
+            // Earlier reductions in this pass might have changed it
+            size_t twin = found->second;
+            found->second = vertex;
+            if (!kernel.alive[twin] || kernel.degrees[twin] != 3 ||
+                !std::ranges::is_permutation(live(kernel, twin),
+                                             neighbours)) {
+                continue;
+            }
+            seen.erase(found);
+
+            auto [first, second, third] = neighbours;
+            if (isAdjacent(kernel, first, second) ||
+                isAdjacent(kernel, first, third) ||
+                isAdjacent(kernel, second, third)) {
+                include(kernel, vertex);
+                include(kernel, twin);
+            } else {
+                merge(kernel, vertex, std::array{twin, first, second, third});
+                kernel.folds.push_back({vertex, neighbours, twin});
+                kernel.offset += 2;
+            }
+            changed = true;
+        }
+        return changed;
+    }
+
+    auto augment(Kernel& kernel, size_t vertex) -> bool {
+        for (size_t other : live(kernel, vertex)) {
+            size_t partner = rightPartner[other];
+            if (partner == NONE ||
+                (distances[partner] == distances[vertex] + 1 &&
+                 augment(kernel, partner))) {
+                leftPartner[vertex] = other;
+                rightPartner[other] = vertex;
+                return true;
+            }
+        }
+        distances[vertex] = NONE;
+        return false;
+    }
+
+    // Nemhauser & Trotter: the vertex cover LP has a half integral optimum,
+    // and some maximum independent set has every vertex the LP puts at 0
+    // and none at 1. The optimum comes from a maximum matching between two
+    // copies of the graph, through König's theorem.
+    auto reduceLp(Kernel& kernel) -> bool {
+        vector<size_t> vertices;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (kernel.alive[vertex]) {
+                vertices.push_back(vertex);
+                leftPartner[vertex] = rightPartner[vertex] = NONE;
+            }
+        }
+
+        // Hopcroft-Karp
+        for (;;) {
+            std::queue<size_t> frontier;
+            for (size_t vertex : vertices) {
+                distances[vertex] = NONE;
+                if (leftPartner[vertex] == NONE) {
+                    distances[vertex] = 0;
+                    frontier.push(vertex);
+                }
+            }
+
+            bool foundFree = false;
+            while (!frontier.empty()) {
+                size_t vertex = frontier.front();
+                frontier.pop();
+                for (size_t other : live(kernel, vertex)) {
+                    size_t partner = rightPartner[other];
+                    if (partner == NONE) {
+                        foundFree = true;
+                    } else if (distances[partner] == NONE) {
+                        distances[partner] = distances[vertex] + 1;
+                        frontier.push(partner);
+                    }
+                }
+            }
+            if (!foundFree) {
+                break;
+            }
+
+            for (size_t vertex : vertices) {
+                if (leftPartner[vertex] == NONE) {
+                    augment(kernel, vertex);
+                }
+            }
+        }
+
+        // König: what the free left vertices reach by alternating paths
+        std::queue<size_t> frontier;
+        for (size_t vertex : vertices) {
+            reachedLeft[vertex] = leftPartner[vertex] == NONE;
+            reachedRight[vertex] = false;
+            if (reachedLeft[vertex]) {
+                frontier.push(vertex);
+            }
+        }
+        while (!frontier.empty()) {
+            size_t vertex = frontier.front();
+            frontier.pop();
+            for (size_t other : live(kernel, vertex)) {
+                if (reachedRight[other]) {
+                    continue;
+                }
+                reachedRight[other] = true;
+                size_t partner = rightPartner[other];
+                if (partner != NONE && !reachedLeft[partner]) {
+                    reachedLeft[partner] = true;
+                    frontier.push(partner);
+                }
+            }
+        }
+
+        // The cover is the unreached left copies and the reached right
+        // ones, a vertex's LP value is half the copies it has in there
+        bool changed = false;
+        for (size_t vertex : vertices) {
+            if (kernel.alive[vertex] && reachedLeft[vertex] &&
+                !reachedRight[vertex]) {
+                include(kernel, vertex);
+                changed = true;
+            }
+        }
+        for (size_t vertex : vertices) {
+            if (kernel.alive[vertex] && !reachedLeft[vertex] &&
+                reachedRight[vertex]) {
+                remove(kernel, vertex);
+                changed = true;
+            }
+        }
+        return changed;
+    }
+
+    auto reduce(Kernel& kernel) -> void {
+        vector<size_t> queue;
+        for (;;) {
+            queue.clear();
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                if (kernel.alive[vertex]) {
+                    queue.push_back(vertex);
+                }
+            }
+            reduceDegrees(kernel, queue);
+
+            if (!reduceDomination(kernel) && !reduceTwins(kernel) &&
+                !reduceLp(kernel)) {
+                return;
+            }
+        }
+    }
+
+    // An independent set has at most one vertex per clique, so any
+    // partition into cliques bounds it. Going from high to low degree, each
+    // vertex joins the biggest clique it's adjacent to all of (Akiba & Iwata).
+    auto cliqueCoverBound(Kernel& kernel) -> size_t {
+        vector<size_t> order;
+        order.reserve(kernel.aliveCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (kernel.alive[vertex]) {
+                order.push_back(vertex);
+            }
+        }
+        std::ranges::sort(order, std::greater{}, [&](size_t vertex) {
+            return kernel.degrees[vertex];
+        });
+
+        vector<size_t> cliqueOf(vertexCount, NONE);
+        vector<size_t> sizes;
+        vector<size_t> hits;
+        vector<size_t> touched;
+        for (size_t vertex : order) {
+            touched.clear();
+            for (size_t other : live(kernel, vertex)) {
+                size_t clique = cliqueOf[other];
+                if (clique != NONE && hits[clique]++ == 0) {
+                    touched.push_back(clique);
+                }
+            }
+
+            size_t joined = NONE;
+            for (size_t clique : touched) {
+                if (hits[clique] == sizes[clique] &&
+                    (joined == NONE || sizes[clique] > sizes[joined])) {
+                    joined = clique;
+                }
+                hits[clique] = 0;
+            }
+
+            if (joined == NONE) {
+                cliqueOf[vertex] = sizes.size();
+                sizes.push_back(1);
+                hits.push_back(0);
+            } else {
+                cliqueOf[vertex] = joined;
+                ++sizes[joined];
+            }
+        }
+        return sizes.size();
+    }
+
+    auto lift(const Kernel& kernel) const -> vector<size_t> {
+        vector<bool> isIn(vertexCount);
+        for (size_t vertex : kernel.included) {
+            isIn[vertex] = true;
+        }
+
+        for (const auto& fold : std::ranges::reverse_view(kernel.folds)) {
+            if (isIn[fold.vertex]) {
+                isIn[fold.vertex] = false;
+                for (size_t part : fold.parts) {
+                    if (part != NONE) {
+                        isIn[part] = true;
+                    }
+                }
+            } else {
+                isIn[fold.vertex] = true;
+                if (fold.twin != NONE) {
+                    isIn[fold.twin] = true;
+                }
+            }
+        }
+
+        vector<size_t> solution;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (isIn[vertex]) {
+                solution.push_back(vertex);
+            }
+        }
+        return solution;
+    }
+
+    // The size anything has to beat to be of use
+    [[nodiscard]] auto target() const -> size_t {
+        size_t size = std::max(best.size(), mustBeat);
+        return isWholeGraph && race != nullptr
+                   ? std::max(size, race->bestSize())
+                   : size;
+    }
+
+    [[nodiscard]] auto isStopped() const -> bool {
+        return race != nullptr && race->exhausted();
+    }
+
+    auto improve(vector<size_t> solution) -> void {
+        best = std::move(solution);
+        if (isWholeGraph && race != nullptr) {
+            race->record(best);
+        }
+    }
+
+    // Min degree greedy, a decent first incumbent
+    auto greedy(Kernel kernel) -> void {
+        using Entry = std::pair<size_t, size_t>;
+        std::priority_queue<Entry, vector<Entry>, std::greater<>> queue;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            queue.emplace(kernel.degrees[vertex], vertex);
+        }
+
+        while (!queue.empty()) {
+            auto [degree, vertex] = queue.top();
+            queue.pop();
+            if (!kernel.alive[vertex] || degree != kernel.degrees[vertex]) {
+                continue;
+            }
+
+            auto neighbours = live(kernel, vertex);
+            include(kernel, vertex);
+            for (size_t neighbour : neighbours) {
+                for (size_t other : kernel.adjacency[neighbour]) {
+                    if (kernel.alive[other]) {
+                        queue.emplace(kernel.degrees[other], other);
+                    }
+                }
+            }
+        }
+
+        std::ranges::sort(kernel.included);
+        improve(std::move(kernel.included));
+    }
+
+    // The vertices of each connected component that's left
+    auto components(Kernel& kernel) -> vector<vector<size_t>> {
+        size_t seen = ++stamp;
+        vector<vector<size_t>> found;
+        for (size_t start = 0; start < vertexCount; ++start) {
+            if (!kernel.alive[start] || marks[start] == seen) {
+                continue;
+            }
+
+            auto& component = found.emplace_back(1, start);
+            marks[start] = seen;
+            for (size_t next = 0; next < component.size(); ++next) {
+                for (size_t other : live(kernel, component[next])) {
+                    if (marks[other] != seen) {
+                        marks[other] = seen;
+                        component.push_back(other);
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    // Solves a component on its own, with its own numbering so the search
+    // there only pays for its size, then takes it out of the kernel
+    auto solveComponent(Kernel& kernel, std::span<const size_t> component,
+                        size_t atLeast) -> void {
+        for (size_t i = 0; i < component.size(); ++i) {
+            localIds[component[i]] = i;
+        }
+
+        vector<vector<size_t>> neighbours(component.size());
+        for (size_t i = 0; i < component.size(); ++i) {
+            for (size_t other : live(kernel, component[i])) {
+                neighbours[i].push_back(localIds[other]);
+            }
+        }
+
+        for (size_t vertex : BranchAndReduce{component.size(), race}.run(
+                 neighbours, atLeast, false)) {
+            kernel.included.push_back(component[vertex]);
+            ++kernel.offset;
+        }
+        for (size_t vertex : component) {
+            remove(kernel, vertex);
+        }
+    }
+
+    // Vertices u two steps away where what's left of N(v) after taking out
+    // N(u) is a clique. When v is out, some neighbours are in, and if u
+    // were in too it could be swapped for v, so u can go out with v.
+    auto mirrors(Kernel& kernel, size_t vertex) -> vector<size_t> {
+        size_t mark = ++stamp;
+        marks[vertex] = mark;
+        const auto& neighbours = live(kernel, vertex);
+        for (size_t other : neighbours) {
+            marks[other] = mark;
+        }
+
+        vector<size_t> candidates;
+        for (size_t neighbour : neighbours) {
+            for (size_t other : live(kernel, neighbour)) {
+                if (marks[other] != mark) {
+                    candidates.push_back(other);
+                }
+            }
+        }
+        std::ranges::sort(candidates);
+        auto [first, last] = std::ranges::unique(candidates);
+        candidates.erase(first, last);
+
+        vector<size_t> rest;
+        std::erase_if(candidates, [&](size_t candidate) {
+            rest.clear();
+            for (size_t other : neighbours) {
+                if (!isAdjacent(kernel, candidate, other)) {
+                    rest.push_back(other);
+                }
+            }
+            for (size_t i = 0; i < rest.size(); ++i) {
+                for (size_t j = i + 1; j < rest.size(); ++j) {
+                    if (!isAdjacent(kernel, rest[i], rest[j])) {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        });
+        return candidates;
+    }
+
+    auto search(Kernel& kernel) -> void {
+        if (isStopped()) {
+            return;
+        }
+
+        reduce(kernel);
+        if (kernel.aliveCount == 0) {
+            if (kernel.offset > best.size()) {
+                improve(lift(kernel));
+            }
+            return;
+        }
+
+        // Once the LP can't settle anything, every vertex is at 1/2
+        size_t bound =
+            std::min(kernel.aliveCount / 2, cliqueCoverBound(kernel));
+        if (kernel.offset + bound <= target()) {
+            return;
+        }
+
+        // Independent parts of the graph don't need to be branched on
+        // together, the tree would be the product of theirs. Once the
+        // kernel is down to half the vertices, renumbering it is worth it
+        // too, every node does a few passes over all of them.
+        if (auto parts = components(kernel);
+            parts.size() > 1 || kernel.aliveCount * 2 <= vertexCount) {
+            // The small ones get solved outright, then the biggest only
+            // has to beat whatever's left of the incumbent
+            std::ranges::sort(parts, {}, &vector<size_t>::size);
+            for (const auto& part :
+                 parts | std::views::take(parts.size() - 1)) {
+                solveComponent(kernel, part, 0);
+            }
+            size_t toBeat = target();
+            solveComponent(kernel, parts.back(),
+                           toBeat > kernel.offset ? toBeat - kernel.offset : 0);
+            if (kernel.offset > best.size()) {
+                improve(lift(kernel));
+            }
+            return;
+        }
+
+        size_t branch = NONE;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (kernel.alive[vertex] &&
+                (branch == NONE ||
+                 kernel.degrees[vertex] > kernel.degrees[branch])) {
+                branch = vertex;
+            }
+        }
+
+        // High degree vertices rarely make it in, so that branch goes
+        // second
+        Kernel without = kernel;
+        for (size_t mirror : mirrors(without, branch)) {
+            remove(without, mirror);
+        }
+        remove(without, branch);
+        search(without);
+
+        include(kernel, branch);
+        search(kernel);
+    }
+
+   public:
+    BranchAndReduce(size_t vertexCount, Race<IgnoreTies>* race)
+        : vertexCount{vertexCount},
+          race{race},
+          marks(vertexCount),
+          leftPartner(vertexCount),
+          rightPartner(vertexCount),
+          distances(vertexCount),
+          reachedLeft(vertexCount),
+          reachedRight(vertexCount),
+          localIds(vertexCount) {}
+
+    // Anything not bigger than atLeast might not be a maximum
+    auto run(const vector<vector<size_t>>& neighbours, size_t atLeast,
+             bool wholeGraph) -> vector<size_t> {
+        mustBeat = atLeast;
+        isWholeGraph = wholeGraph;
+        Kernel root;
+        root.adjacency = neighbours;
+        root.alive.assign(vertexCount, true);
+        root.aliveCount = vertexCount;
+        root.degrees.reserve(vertexCount);
+        for (const auto& list : neighbours) {
+            root.degrees.push_back(list.size());
+        }
+
+        greedy(root);
+        search(root);
+        return best;
+    }
+};
+
+}  // namespace
+
+auto maximumIndependentSet(const vector<vector<size_t>>& neighbours)
+    -> vector<size_t> {
+    return BranchAndReduce{neighbours.size(), nullptr}.run(neighbours, 0,
+                                                           true);
+}
+
+auto maximumIndependentSet(const vector<vector<size_t>>& neighbours,
+                           Race<IgnoreTies>& race) -> void {
+    BranchAndReduce{neighbours.size(), &race}.run(neighbours, 0, true);
+}
+
+}  // namespace clique
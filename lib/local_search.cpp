@@ -0,0 +1,282 @@
+/**
+ * @file local_search.cpp
+ * @brief DLS-MC style local search implementation
+ */
+#include "local_search.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using bits::Word;
+using std::span;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+/**
+ * @brief State of one local search run
+ *
+ * Next to the clique itself, two vertex sets are kept up to date: the ones
+ * that can be added (adjacent to every member) and the ones that can be
+ * swapped in (adjacent to all members but one). Adding a vertex updates both
+ * with a couple of word operations, removing one rebuilds them from
+ * prefix/suffix intersections of the members' rows.
+ */
+class PenaltySearch {
+   private:
+    static constexpr size_t RANDOM_PERTURBATION_INTERVAL = 8;
+
+    const bits::BitMatrix& adjacency;
+    const LocalSearchSettings& settings;
+    size_t vertexCount;
+    size_t stride;
+    std::mt19937_64 generator;
+
+    vector<size_t> penalties;
+
+    // Members, in the order they were added, and as a set
+    vector<size_t> clique;
+    vector<Word> members;
+
+    vector<Word> everything;
+    vector<Word> addable;
+    vector<Word> swappable;
+
+    // Stamps for the current plateau phase: which vertices were in the
+    // clique when it started, and which got swapped out since (those can't
+    // be swapped back in until the next one)
+    size_t plateau{0};
+    vector<size_t> startedIn;
+    size_t overlap{0};
+    vector<Word> swappedOut;
+
+    vector<Word> prefixes;
+    vector<Word> scratch;
+
+    size_t steps{0};
+    size_t rounds{0};
+
+    // Modulo bias is irrelevant at these sizes, and unlike
+    // uniform_int_distribution this gives the same numbers everywhere
+    auto randomBelow(size_t bound) -> size_t {
+        return static_cast<size_t>(generator() % bound);
+    }
+
+    auto add(size_t vertex) -> void {
+        auto row = adjacency[vertex];
+        for (size_t word = 0; word < stride; ++word) {
+            // Swappable ones adjacent to the new member stay swappable,
+            // addable ones that aren't become swappable
+            swappable[word] =
+                (swappable[word] & row[word]) | (addable[word] & ~row[word]);
+        }
+        bits::intersect(addable, row, addable);
+        bits::reset(swappable, vertex);
+
+        clique.push_back(vertex);
+        bits::set(members, vertex);
+    }
+
+    // Rebuilds addable and swappable from scratch. A vertex adjacent to every
+    // member except the i-th is in (rows before i) & (rows after i).
+    auto refresh() -> void {
+        size_t size = clique.size();
+        prefixes.resize((size + 1) * stride);
+        auto prefix = [&](size_t index) {
+            return span{prefixes}.subspan(index * stride, stride);
+        };
+
+        std::ranges::copy(everything, prefix(0).begin());
+        for (size_t i = 0; i < size; ++i) {
+            bits::intersect(prefix(i), adjacency[clique[i]], prefix(i + 1));
+        }
+        std::ranges::copy(prefix(size), addable.begin());
+
+        std::ranges::fill(swappable, 0);
+        std::ranges::copy(everything, scratch.begin());
+        for (size_t i = size; i-- > 0;) {
+            for (size_t word = 0; word < stride; ++word) {
+                swappable[word] |= prefix(i)[word] & scratch[word];
+            }
+            bits::intersect(scratch, adjacency[clique[i]], scratch);
+        }
+        bits::andNot(swappable, addable, swappable);
+        bits::andNot(swappable, members, swappable);
+    }
+
+    // Lowest penalty wins, ties are a uniform pick
+    auto pick(span<const Word> options) -> size_t {
+        size_t chosen = vertexCount;
+        size_t ties = 0;
+        for (size_t vertex = bits::nextSet(options, 0); vertex < vertexCount;
+             vertex = bits::nextSet(options, vertex + 1)) {
+            if (chosen == vertexCount ||
+                penalties[vertex] < penalties[chosen]) {
+                chosen = vertex;
+                ties = 1;
+            } else if (penalties[vertex] == penalties[chosen] &&
+                       randomBelow(++ties) == 0) {
+                chosen = vertex;
+            }
+        }
+
+        return chosen;
+    }
+
+    auto startPlateau() -> void {
+        ++plateau;
+        for (size_t vertex : clique) {
+            startedIn[vertex] = plateau;
+        }
+        overlap = clique.size();
+        std::ranges::fill(swappedOut, 0);
+    }
+
+    // Swaps in a vertex missing one member
+    auto swapIn(size_t vertex) -> void {
+        auto row = adjacency[vertex];
+        auto outcast = std::ranges::find_if(
+            clique, [&](size_t member) { return !bits::test(row, member); });
+
+        if (startedIn[*outcast] == plateau) {
+            --overlap;
+        }
+        bits::set(swappedOut, *outcast);
+        bits::reset(members, *outcast);
+        clique.erase(outcast);
+
+        clique.push_back(vertex);
+        bits::set(members, vertex);
+        refresh();
+    }
+
+    // Expand, then plateau, until neither works. Every maximal clique on
+    // the way gets visited, plateaus included, since cliques of the same
+    // size aren't all equally good to everybody (see modifiedMaxClique)
+    auto climb(const std::function<void(span<const size_t>)>& visit)
+        -> void {
+        for (;;) {
+            while (steps < settings.maxSteps && !bits::none(addable)) {
+                add(pick(addable));
+                ++steps;
+            }
+            if (bits::none(addable)) {
+                visit(clique);
+            }
+
+            startPlateau();
+            while (steps < settings.maxSteps && overlap > 0 &&
+                   bits::none(addable)) {
+                bits::andNot(swappable, swappedOut, scratch);
+                if (bits::none(scratch)) {
+                    break;
+                }
+
+                swapIn(pick(scratch));
+                ++steps;
+                if (bits::none(addable)) {
+                    visit(clique);
+                }
+            }
+
+            if (steps >= settings.maxSteps || bits::none(addable)) {
+                return;
+            }
+        }
+    }
+
+    auto updatePenalties() -> void {
+        for (size_t vertex : clique) {
+            ++penalties[vertex];
+        }
+
+        if (settings.penaltyDelay <= 1 || rounds % settings.penaltyDelay == 0) {
+            for (size_t& penalty : penalties) {
+                penalty -= static_cast<size_t>(penalty > 0);
+            }
+        }
+    }
+
+    auto perturb() -> void {
+        // Keeping the newest member never leaves its neighbourhood, so every
+        // so often a random vertex goes in instead, in case the good
+        // cliques are somewhere else entirely
+        if (settings.penaltyDelay > 1 &&
+            rounds % RANDOM_PERTURBATION_INTERVAL != 0) {
+            size_t newest = clique.back();
+            clique.assign(1, newest);
+        } else {
+            // Force a random vertex in, dropping whatever it's not
+            // adjacent to
+            size_t vertex = randomBelow(vertexCount);
+            auto row = adjacency[vertex];
+            std::erase_if(clique, [&](size_t member) {
+                return member != vertex && !bits::test(row, member);
+            });
+            if (!bits::test(members, vertex)) {
+                clique.push_back(vertex);
+            }
+        }
+
+        std::ranges::fill(members, 0);
+        for (size_t member : clique) {
+            bits::set(members, member);
+        }
+        refresh();
+    }
+
+   public:
+    PenaltySearch(const bits::BitMatrix& adjacency,
+                  const LocalSearchSettings& settings)
+        : adjacency{adjacency},
+          settings{settings},
+          vertexCount{adjacency.getSize()},
+          stride{adjacency.getStride()},
+          generator{settings.seed},
+          penalties(vertexCount),
+          members(stride),
+          everything(stride),
+          addable(stride),
+          swappable(stride),
+          startedIn(vertexCount),
+          swappedOut(stride),
+          scratch(stride) {
+        clique.reserve(vertexCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            bits::set(everything, vertex);
+        }
+    }
+
+    auto run(const std::function<void(span<const size_t>)>& visit) -> void {
+        if (vertexCount == 0) {
+            return;
+        }
+
+        refresh();
+        add(randomBelow(vertexCount));
+        while (steps < settings.maxSteps) {
+            climb(visit);
+            ++rounds;
+            updatePenalties();
+            perturb();
+
+            // Perturbing counts too, or a graph with nothing to climb
+            // would never run out of steps
+            ++steps;
+        }
+    }
+};
+
+}  // namespace
+
+auto localSearch(const bits::BitMatrix& adjacency,
+                 const LocalSearchSettings& settings,
+                 const std::function<void(span<const size_t>)>& visit)
+    -> void {
+    PenaltySearch{adjacency, settings}.run(visit);
+}
+
+}  // namespace clique
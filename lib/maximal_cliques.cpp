@@ -0,0 +1,297 @@
+/**
+ * @file maximal_cliques.cpp
+ * @brief Maximal clique enumeration implementation
+ */
+#include "maximal_cliques.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using bits::Word;
+using std::span;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+/**
+ * @brief Pivoting Bron-Kerbosch on one vertex's neighbourhood at a time
+ *
+ * Every buffer is sized for the biggest neighbourhood up front, and each
+ * subproblem only uses the first few words of each row
+ */
+class NeighbourhoodSearch {
+   private:
+    const bits::BitMatrix& adjacency;
+    const std::function<void(span<const size_t>)>& visit;
+    size_t vertexCount;
+
+    // Where each vertex is in the degeneracy order
+    vector<size_t> position;
+
+    // The current neighbourhood, and each vertex's index in it
+    vector<size_t> neighbours;
+    vector<size_t> localIndex;
+    size_t localStride{0};
+    vector<Word> common;
+
+    // Adjacency between neighbours, then per depth: candidates (P),
+    // excluded (X), and the candidates not covered by the pivot
+    bits::BitMatrix local;
+    bits::BitMatrix candidates;
+    bits::BitMatrix excluded;
+    bits::BitMatrix branches;
+
+    vector<size_t> clique;
+    size_t count{0};
+
+    auto row(bits::BitMatrix& matrix, size_t index) -> span<Word> {
+        return matrix[index].first(localStride);
+    }
+
+    // Fills in P, X and the local adjacency for the cliques starting at
+    // vertex, which are made of it and its later neighbours
+    auto load(size_t vertex) -> void {
+        neighbours.clear();
+        auto vertexRow = adjacency[vertex];
+        for (size_t other = bits::nextSet(vertexRow, 0); other < vertexCount;
+             other = bits::nextSet(vertexRow, other + 1)) {
+            localIndex[other] = neighbours.size();
+            neighbours.push_back(other);
+        }
+        localStride = bits::wordsFor(neighbours.size());
+
+        auto later = row(candidates, 0);
+        auto earlier = row(excluded, 0);
+        std::ranges::fill(later, 0);
+        std::ranges::fill(earlier, 0);
+        for (size_t i = 0; i < neighbours.size(); ++i) {
+            bits::set(position[neighbours[i]] > position[vertex] ? later
+                                                                 : earlier,
+                      i);
+
+            auto localRow = row(local, i);
+            std::ranges::fill(localRow, 0);
+            bits::intersect(adjacency[neighbours[i]], vertexRow, common);
+            for (size_t other = bits::nextSet(common, 0); other < vertexCount;
+                 other = bits::nextSet(common, other + 1)) {
+                bits::set(localRow, localIndex[other]);
+            }
+        }
+    }
+
+    // Reports the clique if it's maximal, otherwise picks the pivot and
+    // says whether there's anything to branch on
+    auto enter(size_t depth) -> bool {
+        auto options = row(candidates, depth);
+        auto done = row(excluded, depth);
+        if (bits::none(options)) {
+            if (bits::none(done)) {
+                ++count;
+                visit(clique);
+            }
+            return false;
+        }
+
+        // Any maximal clique here has a vertex the pivot isn't adjacent to
+        // (or the pivot itself), so only those need branching on
+        size_t pivot = 0;
+        size_t covered = 0;
+        bool hasPivot = false;
+        for (auto group : {options, done}) {
+            for (size_t vertex = bits::nextSet(group, 0);
+                 vertex < neighbours.size();
+                 vertex = bits::nextSet(group, vertex + 1)) {
+                size_t coverage =
+                    bits::intersectCount(options, row(local, vertex));
+                if (!hasPivot || coverage > covered) {
+                    pivot = vertex;
+                    covered = coverage;
+                    hasPivot = true;
+                }
+            }
+        }
+
+        bits::andNot(options, row(local, pivot), row(branches, depth));
+        return true;
+    }
+
+    auto search() -> void {
+        if (!enter(0)) {
+            return;
+        }
+
+        size_t depth = 0;
+        for (;;) {
+            auto todo = row(branches, depth);
+            size_t vertex = bits::nextSet(todo, 0);
+            if (vertex >= neighbours.size()) {
+                if (depth == 0) {
+                    return;
+                }
+                --depth;
+                clique.pop_back();
+                continue;
+            }
+
+            auto options = row(candidates, depth);
+            auto done = row(excluded, depth);
+            auto localRow = row(local, vertex);
+            bits::reset(todo, vertex);
+            bits::intersect(options, localRow, row(candidates, depth + 1));
+            bits::intersect(done, localRow, row(excluded, depth + 1));
+            bits::reset(options, vertex);
+            bits::set(done, vertex);
+
+            clique.push_back(neighbours[vertex]);
+            if (enter(depth + 1)) {
+                ++depth;
+            } else {
+                clique.pop_back();
+            }
+        }
+    }
+
+   public:
+    NeighbourhoodSearch(const bits::BitMatrix& adjacency,
+                        const std::function<void(span<const size_t>)>& visit)
+        : adjacency{adjacency},
+          visit{visit},
+          vertexCount{adjacency.getSize()},
+          position(vertexCount),
+          localIndex(vertexCount),
+          common(adjacency.getStride()) {
+        size_t maxDegree = 0;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            maxDegree = std::max(maxDegree, bits::count(adjacency[vertex]));
+        }
+
+        // Depth never gets past the biggest neighbourhood, plus the start
+        local = bits::BitMatrix{maxDegree};
+        candidates = bits::BitMatrix{maxDegree + 1, maxDegree};
+        excluded = bits::BitMatrix{maxDegree + 1, maxDegree};
+        branches = bits::BitMatrix{maxDegree + 1, maxDegree};
+        neighbours.reserve(maxDegree);
+        clique.reserve(maxDegree + 1);
+    }
+
+    auto run() -> size_t {
+        if (vertexCount == 0) {
+            ++count;
+            visit(clique);
+            return count;
+        }
+
+        auto order = degeneracyOrder(adjacency);
+        for (size_t i = 0; i < vertexCount; ++i) {
+            position[order[i]] = i;
+        }
+
+        for (size_t vertex : order) {
+            load(vertex);
+            clique.assign(1, vertex);
+            search();
+        }
+
+        return count;
+    }
+};
+
+/**
+ * @brief The bucketed smallest-last order behind both degeneracyOrders
+ *
+ * @param degrees every vertex's degree
+ * @param forEachNeighbour called with a vertex and a callable, should call
+ * that with each of the vertex's neighbours
+ *
+ * @return every vertex, in degeneracy order
+ */
+template <typename ForEachNeighbour>
+auto smallestLast(vector<size_t> degrees, ForEachNeighbour forEachNeighbour)
+    -> vector<size_t> {
+    size_t vertexCount = degrees.size();
+    size_t maxDegree = 0;
+    for (size_t degree : degrees) {
+        maxDegree = std::max(maxDegree, degree);
+    }
+
+    // Counting sort by degree, bucketStarts[d] is where degree d begins
+    vector<size_t> bucketStarts(maxDegree + 1);
+    for (size_t degree : degrees) {
+        ++bucketStarts[degree];
+    }
+    size_t start = 0;
+    for (size_t& bucket : bucketStarts) {
+        start += std::exchange(bucket, start);
+    }
+
+    vector<size_t> order(vertexCount);
+    vector<size_t> position(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        position[vertex] = bucketStarts[degrees[vertex]]++;
+        order[position[vertex]] = vertex;
+    }
+    for (size_t degree = maxDegree; degree > 0; --degree) {
+        bucketStarts[degree] = bucketStarts[degree - 1];
+    }
+    bucketStarts[0] = 0;
+
+    // Taking out order[i] moves each later neighbour down a bucket, by
+    // swapping it to the front of its bucket and shrinking the bucket
+    for (size_t i = 0; i < vertexCount; ++i) {
+        size_t vertex = order[i];
+        forEachNeighbour(vertex, [&](size_t other) {
+            if (degrees[other] <= degrees[vertex]) {
+                return;
+            }
+
+            size_t front = bucketStarts[degrees[other]];
+            size_t displaced = order[front];
+            std::swap(order[front], order[position[other]]);
+            std::swap(position[displaced], position[other]);
+            ++bucketStarts[degrees[other]];
+            --degrees[other];
+        });
+    }
+
+    return order;
+}
+
+}  // namespace
+
+auto degeneracyOrder(const bits::BitMatrix& adjacency) -> vector<size_t> {
+    size_t vertexCount = adjacency.getSize();
+    vector<size_t> degrees(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        degrees[vertex] = bits::count(adjacency[vertex]);
+    }
+
+    return smallestLast(std::move(degrees), [&](size_t vertex, auto visit) {
+        auto row = adjacency[vertex];
+        for (size_t other = bits::nextSet(row, 0); other < vertexCount;
+             other = bits::nextSet(row, other + 1)) {
+            visit(other);
+        }
+    });
+}
+
+auto degeneracyOrder(const vector<vector<size_t>>& neighbours)
+    -> vector<size_t> {
+    vector<size_t> degrees(neighbours.size());
+    for (size_t vertex = 0; vertex < neighbours.size(); ++vertex) {
+        degrees[vertex] = neighbours[vertex].size();
+    }
+
+    return smallestLast(std::move(degrees), [&](size_t vertex, auto visit) {
+        std::ranges::for_each(neighbours[vertex], visit);
+    });
+}
+
+auto enumerateMaximalCliques(
+    const bits::BitMatrix& adjacency,
+    const std::function<void(span<const size_t>)>& visit) -> size_t {
+    return NeighbourhoodSearch{adjacency, visit}.run();
+}
+
+}  // namespace clique
@@ -0,0 +1,162 @@
+/**
+ * @file russian_doll.cpp
+ * @brief Russian doll search implementation
+ */
+#include "russian_doll.hpp"
+
+#include <algorithm>
+
+#include "maximal_cliques.hpp"
+
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// State of one search, everything is numbered by position in the order
+class RussianDolls {
+   private:
+    size_t vertexCount;
+
+    // Which vertex sits at each position
+    vector<size_t> order;
+
+    // The adjacency, renumbered by position
+    bits::BitMatrix adjacency;
+
+    // Candidates at each depth of the search
+    bits::BitMatrix candidates;
+
+    // The biggest clique in each doll, for the dolls solved so far
+    vector<size_t> dolls;
+
+    vector<size_t> current;
+    vector<size_t> best;
+
+    // Whether the doll being solved is already one bigger than the last,
+    // which is as big as it gets
+    bool isDone{false};
+
+    // Who else is looking, if anyone
+    Race<IgnoreTies>* race{nullptr};
+
+    // The size to beat, ours or anyone else's in the race
+    [[nodiscard]] auto bound() const -> size_t {
+        return race == nullptr ? best.size()
+                               : std::max(best.size(), race->bestSize());
+    }
+
+    [[nodiscard]] auto isStopped() const -> bool {
+        return race != nullptr && race->exhausted();
+    }
+
+    [[nodiscard]] auto toVertices(const vector<size_t>& positions) const
+        -> vector<size_t> {
+        vector<size_t> clique;
+        clique.reserve(positions.size());
+        for (size_t position : positions) {
+            clique.push_back(order[position]);
+        }
+        std::ranges::sort(clique);
+        return clique;
+    }
+
+    auto improve() -> void {
+        best = current;
+        if (race != nullptr) {
+            race->record(toVertices(best));
+        }
+    }
+
+    auto expand(size_t depth) -> void {
+        auto row = candidates[depth];
+        for (size_t position = bits::nextSet(row, 0); position < vertexCount;
+             position = bits::nextSet(row, position + 1)) {
+            // What's left of the candidates all come from this position's
+            // doll on
+            size_t target = bound();
+            if (current.size() + bits::count(row) <= target ||
+                current.size() + dolls[position] <= target || isStopped()) {
+                return;
+            }
+
+            bits::reset(row, position);
+            current.push_back(position);
+            auto next = candidates[depth + 1];
+            bits::intersect(row, adjacency[position], next);
+            if (!bits::none(next)) {
+                expand(depth + 1);
+            } else if (current.size() > bound()) {
+                improve();
+                isDone = true;
+            }
+            current.pop_back();
+
+            if (isDone) {
+                return;
+            }
+        }
+    }
+
+   public:
+    RussianDolls(const bits::BitMatrix& original, Race<IgnoreTies>* race)
+        : vertexCount{original.getSize()},
+          order{degeneracyOrder(original)},
+          adjacency{vertexCount},
+          candidates{vertexCount + 2, vertexCount},
+          dolls(vertexCount),
+          race{race} {
+        // Smallest-last puts the core at the end, so the first dolls solved
+        // are the dense part, and they bound everything after
+        vector<size_t> positions(vertexCount);
+        for (size_t position = 0; position < vertexCount; ++position) {
+            positions[order[position]] = position;
+        }
+        for (size_t position = 0; position < vertexCount; ++position) {
+            auto row = original[order[position]];
+            for (size_t other = bits::nextSet(row, 0); other < vertexCount;
+                 other = bits::nextSet(row, other + 1)) {
+                bits::set(adjacency[position], positions[other]);
+            }
+        }
+    }
+
+    auto run() -> vector<size_t> {
+        // Positions from the current doll's first vertex on
+        vector<bits::Word> doll(adjacency.getStride());
+
+        for (size_t first = vertexCount; first-- > 0 && !isStopped();) {
+            bits::set(doll, first);
+            isDone = false;
+            current.assign(1, first);
+
+            auto start = candidates[1];
+            bits::intersect(adjacency[first], doll, start);
+            if (!bits::none(start)) {
+                expand(1);
+            } else if (current.size() > bound()) {
+                improve();
+            }
+
+            // Anything here that wasn't bigger got pruned against the
+            // bound, whoever found it
+            dolls[first] = bound();
+        }
+
+        return toVertices(best);
+    }
+};
+
+}  // namespace
+
+auto russianDollSearch(const bits::BitMatrix& adjacency) -> vector<size_t> {
+    return RussianDolls{adjacency, nullptr}.run();
+}
+
+auto russianDollSearch(const bits::BitMatrix& adjacency,
+                       Race<IgnoreTies>& race) -> void {
+    RussianDolls{adjacency, &race}.run();
+}
+
+}  // namespace clique
@@ -0,0 +1,229 @@
+/**
+ * @file symmetry.cpp
+ * @brief Orbit finding implementation
+ */
+#include "symmetry.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <ranges>
+
+#include "color_refinement.hpp"
+
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+class OrbitFinder {
+   private:
+    const bits::BitMatrix& adjacency;
+    size_t vertexCount;
+    vector<vector<size_t>> neighbours;
+
+    size_t roundLimit;
+    size_t roundCount{0};
+
+    // Buffers shared by every refinement, lhs and rhs both colour this graph
+    ColorRefinement<0> refinement;
+
+    // Union-find over the orbits, the smallest vertex is always the root
+    vector<size_t> parent;
+
+    [[nodiscard]] auto find(size_t vertex) -> size_t {
+        while (parent[vertex] != vertex) {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+        return vertex;
+    }
+
+    auto merge(size_t first, size_t second) -> void {
+        first = find(first);
+        second = find(second);
+        parent[std::max(first, second)] = std::min(first, second);
+    }
+
+    // Refines two colourings of the graph together until they're stable,
+    // with one palette, so equal colours mean the same thing in both. Every
+    // round is charged to the budget, nullopt once it's spent.
+    auto refine(vector<size_t>& lhs, vector<size_t>& rhs)
+        -> std::optional<size_t> {
+        refinement.startSignatures(1);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            refinement.signature(vertex)[0] = lhs[vertex];
+            refinement.signature(vertexCount + vertex)[0] = rhs[vertex];
+        }
+        size_t colorCount = refinement.recolor();
+
+        for (;;) {
+            if (roundCount >= roundLimit) {
+                return std::nullopt;
+            }
+            ++roundCount;
+            size_t next = refinement.refineNeighbours(neighbours, neighbours);
+            if (next == colorCount) {
+                break;
+            }
+            colorCount = next;
+        }
+
+        auto colors = refinement.getColors();
+        std::ranges::copy(colors.first(vertexCount), lhs.begin());
+        std::ranges::copy(colors.subspan(vertexCount), rhs.begin());
+        return colorCount;
+    }
+
+    [[nodiscard]] auto isAutomorphism(const vector<size_t>& mapping) const
+        -> bool {
+        return std::ranges::all_of(
+            std::views::iota(size_t{0}, vertexCount), [&](size_t vertex) {
+                return std::ranges::all_of(
+                    neighbours[vertex], [&](size_t other) {
+                        return bits::test(adjacency[mapping[vertex]],
+                                          mapping[other]);
+                    });
+            });
+    }
+
+    // Looks for an automorphism taking every vertex of each colour in lhs to
+    // the vertex of that colour in rhs, individualizing a vertex of the
+    // smallest class whenever refinement gets stuck
+    auto search(vector<size_t> lhs, vector<size_t> rhs)
+        -> std::optional<vector<size_t>> {
+        auto refined = refine(lhs, rhs);
+        if (!refined) {
+            return std::nullopt;
+        }
+        size_t colorCount = *refined;
+
+        vector<size_t> lhsSizes(colorCount);
+        vector<size_t> rhsSizes(colorCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            ++lhsSizes[lhs[vertex]];
+            ++rhsSizes[rhs[vertex]];
+        }
+        if (lhsSizes != rhsSizes) {
+            return std::nullopt;
+        }
+
+        if (colorCount == vertexCount) {
+            vector<size_t> byColor(vertexCount);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                byColor[rhs[vertex]] = vertex;
+            }
+            vector<size_t> mapping(vertexCount);
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                mapping[vertex] = byColor[lhs[vertex]];
+            }
+            if (isAutomorphism(mapping)) {
+                return mapping;
+            }
+            return std::nullopt;
+        }
+
+        size_t target = 0;
+        for (size_t color = 0; color < colorCount; ++color) {
+            if (lhsSizes[color] > 1 &&
+                (lhsSizes[target] <= 1 ||
+                 lhsSizes[color] < lhsSizes[target])) {
+                target = color;
+            }
+        }
+        auto lhsVertex = static_cast<size_t>(
+            std::ranges::find(lhs, target) - lhs.begin());
+
+        // The same vertex first, automorphisms tend to fix most of them
+        vector<size_t> images;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if (rhs[vertex] == target) {
+                images.push_back(vertex);
+            }
+        }
+        std::ranges::stable_partition(
+            images, [&](size_t vertex) { return vertex == lhsVertex; });
+
+        for (size_t image : images) {
+            auto lhsNext = lhs;
+            auto rhsNext = rhs;
+            lhsNext[lhsVertex] = rhsNext[image] = colorCount;
+            if (auto found = search(std::move(lhsNext), std::move(rhsNext))) {
+                return found;
+            }
+            if (roundCount >= roundLimit) {
+                break;
+            }
+        }
+        return std::nullopt;
+    }
+
+   public:
+    OrbitFinder(const bits::BitMatrix& adjacency, size_t roundLimit)
+        : adjacency{adjacency},
+          vertexCount{adjacency.getSize()},
+          neighbours(vertexCount),
+          roundLimit{roundLimit},
+          refinement{vertexCount},
+          parent(vertexCount) {
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            for (size_t other = bits::nextSet(adjacency[vertex], 0);
+                 other < vertexCount;
+                 other = bits::nextSet(adjacency[vertex], other + 1)) {
+                neighbours[vertex].push_back(other);
+            }
+        }
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    auto run() -> vector<size_t> {
+        // Both sides start out the same, one colour for everything. Without
+        // the budget for even this, every vertex stays on its own.
+        vector<size_t> colors(vertexCount);
+        vector<size_t> same(vertexCount);
+        size_t colorCount = refine(colors, same).value_or(vertexCount);
+
+        for (size_t vertex = 0;
+             vertex < vertexCount && colorCount < vertexCount &&
+             roundCount < roundLimit;
+             ++vertex) {
+            // Already mapped onto an earlier orbit by some automorphism
+            if (find(vertex) != vertex) {
+                continue;
+            }
+
+            for (size_t earlier = 0; earlier < vertex; ++earlier) {
+                if (colors[earlier] != colors[vertex] ||
+                    find(earlier) != earlier) {
+                    continue;
+                }
+
+                auto lhs = colors;
+                auto rhs = colors;
+                lhs[earlier] = rhs[vertex] = colorCount;
+                if (auto found = search(std::move(lhs), std::move(rhs))) {
+                    for (size_t other = 0; other < vertexCount; ++other) {
+                        merge(other, (*found)[other]);
+                    }
+                    break;
+                }
+            }
+        }
+
+        vector<size_t> orbits(vertexCount);
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            orbits[vertex] = find(vertex);
+        }
+        return orbits;
+    }
+};
+
+}  // namespace
+
+auto vertexOrbits(const bits::BitMatrix& adjacency, size_t roundLimit)
+    -> vector<size_t> {
+    return OrbitFinder{adjacency, roundLimit}.run();
+}
+
+}  // namespace clique
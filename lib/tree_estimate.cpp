@@ -0,0 +1,118 @@
+/**
+ * @file tree_estimate.cpp
+ * @brief Knuth style search tree estimator implementation
+ */
+#include "tree_estimate.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "maximal_cliques.hpp"
+
+using bits::Word;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// As good as never, and far from overflowing nanoseconds
+constexpr std::chrono::hours FOREVER{24 * 365 * 100};
+
+// One random walk down the search tree
+class Probe {
+   private:
+    const bits::BitMatrix& adjacency;
+    size_t vertexCount;
+    size_t target;
+
+    vector<Word> candidates;
+    vector<Word> uncolored;
+    vector<Word> colorClass;
+
+   public:
+    Probe(const bits::BitMatrix& adjacency, size_t target)
+        : adjacency{adjacency},
+          vertexCount{adjacency.getSize()},
+          target{target},
+          candidates(adjacency.getStride()),
+          uncolored(adjacency.getStride()),
+          colorClass(adjacency.getStride()) {}
+
+    // The walk's estimate of the expanded node count, the ones it expands
+    // itself get added to visited
+    auto run(std::mt19937_64& generator, size_t& visited) -> double {
+        std::ranges::fill(candidates, Word{0});
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            bits::set(candidates, vertex);
+        }
+
+        double estimate = 0;
+        double weight = 1;
+        for (size_t depth = 0;; ++depth) {
+            // Same checks, in the same order, as Graph::maxCliqueHelper
+            size_t candidateCount = bits::count(candidates);
+            if (candidateCount == 0 || depth + candidateCount < target ||
+                depth + coloringBound(adjacency, candidates, uncolored,
+                                      colorClass) <
+                    target) {
+                return estimate;
+            }
+            estimate += weight;
+            ++visited;
+
+            // The loop there stops at the first vertex that leaves too few
+            // candidates behind, so only a prefix of them get branches
+            size_t children =
+                std::min(candidateCount, depth + candidateCount + 1 - target);
+            weight *= static_cast<double>(children);
+
+            std::uniform_int_distribution<size_t> pick{0, children - 1};
+            size_t skipped = pick(generator);
+            size_t vertex = bits::nextSet(candidates, 0);
+            for (; skipped > 0; --skipped) {
+                bits::reset(candidates, vertex);
+                vertex = bits::nextSet(candidates, vertex + 1);
+            }
+            bits::reset(candidates, vertex);
+            bits::intersect(candidates, adjacency[vertex], candidates);
+        }
+    }
+};
+
+}  // namespace
+
+auto estimateTreeSize(const bits::BitMatrix& adjacency,
+                      const EstimateSettings& settings) -> TreeEstimate {
+    TreeEstimate nothing{0, std::chrono::nanoseconds{0}, 0};
+    if (adjacency.getSize() == 0 || settings.probes == 0) {
+        return nothing;
+    }
+
+    std::mt19937_64 generator{settings.seed};
+    Probe probe{adjacency, settings.target};
+
+    auto start = std::chrono::steady_clock::now();
+    double total = 0;
+    size_t visited = 0;
+    for (size_t i = 0; i < settings.probes; ++i) {
+        total += probe.run(generator, visited);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (visited == 0) {
+        return nothing;
+    }
+
+    double nodes = total / static_cast<double>(settings.probes);
+    std::chrono::duration<double, std::nano> perNode =
+        elapsed / static_cast<double>(visited);
+
+    // Capped well before it overflows, nobody's waiting that long anyway
+    auto time = std::min(perNode * nodes,
+                         std::chrono::duration<double, std::nano>{FOREVER});
+    return {nodes, std::chrono::duration_cast<std::chrono::nanoseconds>(time),
+            visited};
+}
+
+}  // namespace clique
@@ -0,0 +1,67 @@
+/**
+ * @file triangles.cpp
+ * @brief Triangle counting implementation
+ */
+#include "triangles.hpp"
+
+#include <algorithm>
+
+#include "work_stealing.hpp"
+
+using std::uint64_t;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// Rows per task, enough that a task is worth stealing
+constexpr size_t ROW_BLOCK = 64;
+
+}  // namespace
+
+auto countTriangles(const bits::BitMatrix& adjacency, size_t threadCount)
+    -> TriangleCounts {
+    size_t vertexCount = adjacency.getSize();
+    TriangleCounts counts{0, vector<uint64_t>(vertexCount),
+                          vector<double>(vertexCount)};
+
+    // Each task fills in its own rows and nobody else's
+    WorkStealingPool<size_t> pool{threadCount};
+    size_t workerCount = pool.getWorkerCount();
+    for (size_t first = 0, block = 0; first < vertexCount;
+         first += ROW_BLOCK, ++block) {
+        pool.push(block % workerCount, first);
+    }
+
+    pool.run([&](size_t /*worker*/) {
+        return [&](size_t&& first) {
+            size_t last = std::min(first + ROW_BLOCK, vertexCount);
+            for (size_t vertex = first; vertex < last; ++vertex) {
+                auto row = adjacency[vertex];
+                uint64_t shared = 0;
+                for (size_t other = bits::nextSet(row, 0); other < vertexCount;
+                     other = bits::nextSet(row, other + 1)) {
+                    shared += bits::intersectCount(row, adjacency[other]);
+                }
+
+                // Each triangle shows up from both of its other corners
+                counts.perVertex[vertex] = shared / 2;
+                auto degree = static_cast<double>(bits::count(row));
+                if (degree >= 2) {
+                    counts.clustering[vertex] =
+                        static_cast<double>(shared) / (degree * (degree - 1));
+                }
+            }
+        };
+    });
+
+    // And each one from all three corners
+    for (uint64_t triangles : counts.perVertex) {
+        counts.total += triangles;
+    }
+    counts.total /= 3;
+    return counts;
+}
+
+}  // namespace clique
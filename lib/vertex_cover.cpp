@@ -0,0 +1,300 @@
+/**
+ * @file vertex_cover.cpp
+ * @brief Vertex cover kernelisation and search implementation
+ */
+#include "vertex_cover.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using bits::Word;
+using std::span;
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+/**
+ * @brief State of one minimum vertex cover search
+ *
+ * The graph left at each depth of the search is a bitset of the vertices
+ * still in it, edges being whatever the adjacency says between those
+ */
+class CoverSearch {
+   private:
+    static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+    const bits::BitMatrix& adjacency;
+    size_t vertexCount;
+
+    // Vertices still in the graph, one row per depth of the search
+    bits::BitMatrix remaining;
+
+    // The cover so far, undone by truncating on the way back up
+    vector<size_t> cover;
+
+    vector<Word> neighbours;
+    vector<Word> unmatched;
+
+    // Bipartite matching for the crown, indexed by vertex
+    vector<size_t> partner;
+    vector<Word> visited;
+
+    auto degree(span<const Word> alive, size_t vertex) const -> size_t {
+        return bits::intersectCount(adjacency[vertex], alive);
+    }
+
+    // Greedy maximal matching, leaves the unmatched vertices in unmatched.
+    // Its size is a lower bound on the cover, one end of each edge.
+    auto maximalMatching(span<const Word> alive) -> size_t {
+        std::ranges::copy(alive, unmatched.begin());
+        size_t size = 0;
+        for (size_t vertex = bits::nextSet(unmatched, 0); vertex < vertexCount;
+             vertex = bits::nextSet(unmatched, vertex + 1)) {
+            bits::intersect(adjacency[vertex], unmatched, neighbours);
+            size_t other = bits::nextSet(neighbours, 0);
+            if (other < vertexCount) {
+                bits::reset(unmatched, vertex);
+                bits::reset(unmatched, other);
+                ++size;
+            }
+        }
+        return size;
+    }
+
+    // Kuhn's augmenting path, from an outsider into its neighbourhood
+    auto augment(span<const Word> alive, size_t outsider) -> bool {
+        for (size_t vertex = bits::nextSet(adjacency[outsider], 0);
+             vertex < vertexCount;
+             vertex = bits::nextSet(adjacency[outsider], vertex + 1)) {
+            if (!bits::test(alive, vertex) || bits::test(visited, vertex)) {
+                continue;
+            }
+
+            bits::set(visited, vertex);
+            if (partner[vertex] == NONE || augment(alive, partner[vertex])) {
+                partner[vertex] = outsider;
+                partner[outsider] = vertex;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Outsiders of a maximal matching are independent. Matching them into
+    // their neighbourhood, the unmatched ones grow into a crown: an
+    // independent set I, and H = N(I) matched into I. Some minimum cover
+    // has all of H and none of I.
+    auto crown(span<Word> alive) -> bool {
+        maximalMatching(alive);
+        vector<Word> outsiders{unmatched};
+        if (bits::none(outsiders)) {
+            return false;
+        }
+
+        std::ranges::fill(partner, NONE);
+        for (size_t vertex = bits::nextSet(outsiders, 0); vertex < vertexCount;
+             vertex = bits::nextSet(outsiders, vertex + 1)) {
+            std::ranges::fill(visited, 0);
+            augment(alive, vertex);
+        }
+
+        vector<Word> independent(outsiders.size());
+        for (size_t vertex = bits::nextSet(outsiders, 0); vertex < vertexCount;
+             vertex = bits::nextSet(outsiders, vertex + 1)) {
+            if (partner[vertex] == NONE) {
+                bits::set(independent, vertex);
+            }
+        }
+        if (bits::none(independent)) {
+            return false;
+        }
+
+        vector<Word> head(outsiders.size());
+        for (bool grew = true; grew;) {
+            grew = false;
+            for (size_t vertex = bits::nextSet(independent, 0);
+                 vertex < vertexCount;
+                 vertex = bits::nextSet(independent, vertex + 1)) {
+                bits::intersect(adjacency[vertex], alive, neighbours);
+                for (size_t other = bits::nextSet(neighbours, 0);
+                     other < vertexCount;
+                     other = bits::nextSet(neighbours, other + 1)) {
+                    if (bits::test(head, other)) {
+                        continue;
+                    }
+                    bits::set(head, other);
+                    bits::set(independent, partner[other]);
+                    grew = true;
+                }
+            }
+        }
+
+        for (size_t vertex = bits::nextSet(head, 0); vertex < vertexCount;
+             vertex = bits::nextSet(head, vertex + 1)) {
+            cover.push_back(vertex);
+        }
+        bits::andNot(alive, head, alive);
+        bits::andNot(alive, independent, alive);
+        return true;
+    }
+
+    auto take(span<Word> alive, size_t vertex, size_t& budget) -> bool {
+        if (budget == 0) {
+            return false;
+        }
+        --budget;
+        cover.push_back(vertex);
+        bits::reset(alive, vertex);
+        return true;
+    }
+
+    // Applies the degree rules until none applies anymore
+    auto reduce(span<Word> alive, size_t& budget) -> bool {
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (size_t vertex = bits::nextSet(alive, 0); vertex < vertexCount;
+                 vertex = bits::nextSet(alive, vertex + 1)) {
+                bits::intersect(adjacency[vertex], alive, neighbours);
+                size_t vertexDegree = bits::count(neighbours);
+                size_t first = bits::nextSet(neighbours, 0);
+
+                if (vertexDegree == 0) {
+                    // Nothing to cover
+                    bits::reset(alive, vertex);
+                } else if (vertexDegree == 1) {
+                    // The neighbour covers at least as much as the leaf
+                    if (!take(alive, first, budget)) {
+                        return false;
+                    }
+                } else if (vertexDegree > budget) {
+                    // Buss: leaving it out would take all its neighbours
+                    if (!take(alive, vertex, budget)) {
+                        return false;
+                    }
+                } else if (vertexDegree == 2) {
+                    // In a triangle, both neighbours can do the vertex's job
+                    size_t second = bits::nextSet(neighbours, first + 1);
+                    if (!bits::test(adjacency[first], second)) {
+                        continue;
+                    }
+                    if (!take(alive, first, budget) ||
+                        !take(alive, second, budget)) {
+                        return false;
+                    }
+                } else {
+                    continue;
+                }
+                changed = true;
+            }
+        }
+        return true;
+    }
+
+    // Whether a cover of at most budget more vertices exists, leaving it in
+    // cover if so
+    auto search(size_t depth, size_t budget) -> bool {
+        auto alive = remaining[depth];
+        if (!reduce(alive, budget)) {
+            return false;
+        }
+
+        // Buss again: every degree is at most budget now
+        size_t edgeCount = 0;
+        size_t branchVertex = NONE;
+        size_t branchDegree = 0;
+        for (size_t vertex = bits::nextSet(alive, 0); vertex < vertexCount;
+             vertex = bits::nextSet(alive, vertex + 1)) {
+            size_t vertexDegree = degree(alive, vertex);
+            edgeCount += vertexDegree;
+            if (vertexDegree > branchDegree) {
+                branchVertex = vertex;
+                branchDegree = vertexDegree;
+            }
+        }
+        edgeCount /= 2;
+        if (edgeCount == 0) {
+            return true;
+        }
+        if (edgeCount > budget * budget || maximalMatching(alive) > budget) {
+            return false;
+        }
+
+        size_t coverSize = cover.size();
+        auto child = remaining[depth + 1];
+
+        std::ranges::copy(alive, child.begin());
+        bits::reset(child, branchVertex);
+        cover.push_back(branchVertex);
+        if (search(depth + 1, budget - 1)) {
+            return true;
+        }
+        cover.resize(coverSize);
+
+        // Leaving it out means every neighbour is in
+        if (branchDegree <= budget) {
+            bits::intersect(adjacency[branchVertex], alive, neighbours);
+            bits::andNot(alive, neighbours, child);
+            bits::reset(child, branchVertex);
+            for (size_t vertex = bits::nextSet(neighbours, 0);
+                 vertex < vertexCount;
+                 vertex = bits::nextSet(neighbours, vertex + 1)) {
+                cover.push_back(vertex);
+            }
+            if (search(depth + 1, budget - branchDegree)) {
+                return true;
+            }
+            cover.resize(coverSize);
+        }
+
+        return false;
+    }
+
+   public:
+    explicit CoverSearch(const bits::BitMatrix& adjacency)
+        : adjacency{adjacency},
+          vertexCount{adjacency.getSize()},
+          remaining{vertexCount + 2, vertexCount},
+          neighbours(adjacency.getStride()),
+          unmatched(adjacency.getStride()),
+          partner(vertexCount),
+          visited(adjacency.getStride()) {
+        cover.reserve(vertexCount);
+    }
+
+    auto run() -> vector<size_t> {
+        auto alive = remaining[0];
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            bits::set(alive, vertex);
+        }
+
+        size_t unlimited = vertexCount;
+        reduce(alive, unlimited);
+        while (crown(alive)) {
+            reduce(alive, unlimited);
+        }
+
+        // Each search redoes the work of the ones before, but those are the
+        // smaller ones, O(1.47^k) doesn't mind
+        size_t kernelCover = cover.size();
+        for (size_t budget = maximalMatching(alive);; ++budget) {
+            std::ranges::copy(alive, remaining[1].begin());
+            if (search(1, budget)) {
+                break;
+            }
+            cover.resize(kernelCover);
+        }
+
+        std::ranges::sort(cover);
+        return cover;
+    }
+};
+
+}  // namespace
+
+auto minimumVertexCover(const bits::BitMatrix& adjacency) -> vector<size_t> {
+    return CoverSearch{adjacency}.run();
+}
+
+}  // namespace clique
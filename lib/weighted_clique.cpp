@@ -0,0 +1,268 @@
+/**
+ * @file weighted_clique.cpp
+ * @brief Tie-breaking max clique implementation
+ */
+#include "weighted_clique.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <functional>
+#include <numeric>
+#include <span>
+
+#include "bitset.hpp"
+#include "maximal_cliques.hpp"
+
+using std::vector;
+
+namespace clique {
+
+namespace {
+
+// What cliques get compared by, most important first
+struct Score {
+    size_t size{0};
+    size_t connections{0};
+    size_t edges{0};
+
+    auto operator<=>(const Score&) const = default;
+};
+
+class HeaviestClique {
+   private:
+    size_t vertexCount;
+    bits::BitMatrix adjacency;
+
+    // Per pair: the directions with an edge, and the edges both ways
+    vector<vector<size_t>> connections;
+    vector<vector<size_t>> edges;
+
+    // The most edges between any two vertices
+    size_t heaviestPair{0};
+
+    // Candidates at each depth, plus two rows for coloringBound
+    bits::BitMatrix candidates;
+
+    vector<size_t> current;
+    Score score;
+    vector<size_t> best;
+    Score bestScore;
+
+    // Per depth, each candidate's connections and edges to the clique
+    // there. Keeping them up to date on every push costs more than it
+    // saves, most candidates get pruned before anyone asks, so a depth's
+    // sums only get filled in by a tie check, and go stale once the search
+    // leaves that node. Rows are allocated on first use.
+    vector<vector<size_t>> connectionSums;
+    vector<vector<size_t>> edgeSums;
+    vector<bool> hasSums;
+
+    // What each candidate would add, for the tie bound
+    vector<size_t> connectionGains;
+    vector<size_t> edgeGains;
+
+    // What adding a vertex to the current clique adds, O(1) with sums
+    [[nodiscard]] auto gain(size_t vertex) const -> Score {
+        size_t depth = current.size();
+        if (hasSums[depth]) {
+            return {1, connectionSums[depth][vertex], edgeSums[depth][vertex]};
+        }
+
+        Score added{1, 0, 0};
+        for (size_t member : current) {
+            added.connections += connections[vertex][member];
+            added.edges += edges[vertex][member];
+        }
+        return added;
+    }
+
+    // Fills in the sums at the current depth for the candidates in row,
+    // from the parent's in one step if it has them
+    auto fillSums(std::span<const bits::Word> row) -> void {
+        size_t depth = current.size();
+        if (hasSums[depth]) {
+            return;
+        }
+
+        auto& connectionsHere = connectionSums[depth];
+        auto& edgesHere = edgeSums[depth];
+        connectionsHere.resize(vertexCount);
+        edgesHere.resize(vertexCount);
+        if (depth > 0 && hasSums[depth - 1]) {
+            size_t last = current.back();
+            for (size_t vertex = bits::nextSet(row, 0); vertex < vertexCount;
+                 vertex = bits::nextSet(row, vertex + 1)) {
+                connectionsHere[vertex] = connectionSums[depth - 1][vertex] +
+                                          connections[last][vertex];
+                edgesHere[vertex] =
+                    edgeSums[depth - 1][vertex] + edges[last][vertex];
+            }
+        } else {
+            for (size_t vertex = bits::nextSet(row, 0); vertex < vertexCount;
+                 vertex = bits::nextSet(row, vertex + 1)) {
+                auto added = gain(vertex);
+                connectionsHere[vertex] = added.connections;
+                edgesHere[vertex] = added.edges;
+            }
+        }
+        hasSums[depth] = true;
+    }
+
+    // Sum of the biggest few
+    static auto sumOfBest(vector<size_t>& values, size_t count) -> size_t {
+        std::ranges::partial_sort(values, values.begin() + count,
+                                  std::greater{});
+        return std::accumulate(values.begin(), values.begin() + count,
+                               size_t{0});
+    }
+
+    // Whether a branch that can only get to the best size could still beat
+    // the best clique on connections or edges. The missing vertices each
+    // bring at most the best gains against the current clique, and at most
+    // 2 connections and heaviestPair edges per pair among themselves.
+    auto canWinTie(std::span<const bits::Word> row) -> bool {
+        size_t missing = bestScore.size - current.size();
+        fillSums(row);
+        connectionGains.clear();
+        edgeGains.clear();
+        for (size_t vertex = bits::nextSet(row, 0); vertex < vertexCount;
+             vertex = bits::nextSet(row, vertex + 1)) {
+            auto added = gain(vertex);
+            connectionGains.push_back(added.connections);
+            edgeGains.push_back(added.edges);
+        }
+
+        size_t pairs = missing * (missing - 1) / 2;
+        Score bound{bestScore.size,
+                    score.connections + sumOfBest(connectionGains, missing) +
+                        2 * pairs,
+                    score.edges + sumOfBest(edgeGains, missing) +
+                        heaviestPair * pairs};
+        return bound > bestScore;
+    }
+
+    auto expand(size_t depth) -> void {
+        // Ties don't replace the best, and the search goes through cliques
+        // in lexicographic order, so the best stays the first one found
+        if (score > bestScore) {
+            best = current;
+            bestScore = score;
+        }
+
+        auto row = candidates[depth];
+        if (bits::none(row) ||
+            current.size() + bits::count(row) < bestScore.size) {
+            return;
+        }
+
+        size_t reachable =
+            current.size() + coloringBound(adjacency, row,
+                                           candidates[vertexCount + 1],
+                                           candidates[vertexCount + 2]);
+        if (reachable < bestScore.size ||
+            (reachable == bestScore.size && !canWinTie(row))) {
+            return;
+        }
+
+        auto next = candidates[depth + 1];
+        for (size_t vertex = bits::nextSet(row, 0); vertex < vertexCount;
+             vertex = bits::nextSet(row, vertex + 1)) {
+            bits::reset(row, vertex);
+            if (current.size() + 1 + bits::count(row) < bestScore.size) {
+                break;
+            }
+
+            auto added = gain(vertex);
+            bits::intersect(row, adjacency[vertex], next);
+            hasSums[current.size() + 1] = false;
+            current.push_back(vertex);
+            score.size += added.size;
+            score.connections += added.connections;
+            score.edges += added.edges;
+
+            expand(depth + 1);
+
+            current.pop_back();
+            score.size -= added.size;
+            score.connections -= added.connections;
+            score.edges -= added.edges;
+        }
+    }
+
+   public:
+    explicit HeaviestClique(const vector<vector<int>>& multiplicities)
+        : vertexCount{multiplicities.size()},
+          adjacency{vertexCount},
+          connections(vertexCount, vector<size_t>(vertexCount)),
+          edges(vertexCount, vector<size_t>(vertexCount)),
+          candidates{vertexCount + 3, vertexCount},
+          connectionSums(vertexCount + 1),
+          edgeSums(vertexCount + 1),
+          hasSums(vertexCount + 1) {
+        for (size_t i = 0; i < vertexCount; ++i) {
+            for (size_t j = 0; j < vertexCount; ++j) {
+                int there = multiplicities[i][j];
+                int back = multiplicities[j][i];
+                if (i == j || (there <= 0 && back <= 0)) {
+                    continue;
+                }
+
+                bits::set(adjacency[i], j);
+                connections[i][j] = static_cast<size_t>(there > 0) +
+                                    static_cast<size_t>(back > 0);
+                edges[i][j] = static_cast<size_t>(there + back);
+                heaviestPair = std::max(heaviestPair, edges[i][j]);
+            }
+        }
+        // Nothing to sum up against the empty clique
+        connectionSums[0].resize(vertexCount);
+        edgeSums[0].resize(vertexCount);
+        hasSums[0] = true;
+
+        current.reserve(vertexCount);
+        connectionGains.reserve(vertexCount);
+        edgeGains.reserve(vertexCount);
+    }
+
+    auto run() -> vector<size_t> {
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            bits::set(candidates[0], vertex);
+        }
+        expand(0);
+        return best;
+    }
+};
+
+}  // namespace
+
+auto heaviestMaxClique(const vector<vector<int>>& multiplicities)
+    -> vector<size_t> {
+    return HeaviestClique{multiplicities}.run();
+}
+
+auto HeaviestTies::record(const vector<size_t>& clique) -> void {
+    // Most cliques are smaller, no point scoring those
+    if (clique.size() < best.size()) {
+        return;
+    }
+
+    Score score{clique.size(), 0, 0};
+    for (size_t i = 0; i < clique.size(); ++i) {
+        for (size_t j = i + 1; j < clique.size(); ++j) {
+            int there = multiplicities[clique[i]][clique[j]];
+            int back = multiplicities[clique[j]][clique[i]];
+            score.connections += static_cast<size_t>(there > 0) +
+                                 static_cast<size_t>(back > 0);
+            score.edges += static_cast<size_t>(there + back);
+        }
+    }
+
+    Score bestScore{best.size(), bestConnections, bestEdges};
+    if (score > bestScore || (score == bestScore && clique < best)) {
+        best = clique;
+        bestConnections = score.connections;
+        bestEdges = score.edges;
+    }
+}
+
+}  // namespace clique
@@ -23,14 +23,17 @@ using std::span;
  *
  * @param argc should be >=3
  * @param argv should have the filename to read at [1] and [2]\n
- * if either are "-", stdin will be read instead for that one
+ * if either are "-", stdin will be read instead for that one\n
+ * "--explain" after them prints the first graph's statistics and what the
+ * check is going to do on stderr first, see Graph::planIsomorphism
  *
  * @return 0, or 1 for parse errors
  */
 auto main(int argc, char* argv[]) -> int {
     auto args = span(argv, static_cast<size_t>(argc));
     if (argc < 3) {
-        cerr << "Usage: " << args[0] << " <filename1> <filename2>\n";
+        cerr << "Usage: " << args[0]
+             << " <filename1> <filename2> [--explain]\n";
         return 1;
     }
 
@@ -44,5 +47,14 @@ auto main(int argc, char* argv[]) -> int {
         return 1;
     }
 
+    for (size_t i = 3; i < args.size(); ++i) {
+        if (strcmp(args[i], "--explain") == 0) {
+            cerr << lhs.planIsomorphism(rhs);
+        } else {
+            cerr << "Oops! [unknown option: " << args[i] << "]\n";
+            return 1;
+        }
+    }
+
     cout << (lhs == rhs ? "" : "NOT ") << "Isomorphic.\n";
 }
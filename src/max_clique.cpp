@@ -3,10 +3,17 @@
  * @brief Tool to calculate distance between .homenda.txt graphs
  */
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <optional>
 #include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #include "graph.hpp"
 
@@ -16,22 +23,96 @@ using std::exception;
 using std::for_each;
 using std::span;
 
+namespace {
+
+/**
+ * @brief Parses what "--hint" and "--order" take
+ *
+ * @param list comma separated vertices, like "0,4,7"
+ *
+ * @throws std::invalid_argument or std::out_of_range from std::stoul
+ *
+ * @return the vertices, in the same order
+ */
+auto parseVertices(std::string_view list) -> std::vector<size_t> {
+    std::vector<size_t> vertices;
+    for (size_t start = 0; start <= list.size();) {
+        size_t end = std::min(list.find(',', start), list.size());
+        vertices.push_back(
+            std::stoul(std::string{list.substr(start, end - start)}));
+        start = end + 1;
+    }
+    return vertices;
+}
+
+}  // namespace
+
 /**
  * @brief Max clique between two graphs.
  *
  * @param argc should be >=2
  * @param argv should have the filename to read at [1]\n
  * if it's "-", stdin will be read instead\n
- * if [2] == "approx", an approximate algorithm will be used for the check
- * instead\n
- * if [3] is "dot", it'll convert the output to DOT language
+ * the rest are options, in any order:\n
+ * "approx": an approximate algorithm will be used for the check instead\n
+ * "exact": the default, the exact algorithm\n
+ * "auto": the exact algorithm if it's estimated to fit in the budget, the
+ * approximate one otherwise, see AlgorithmAccuracy::AUTO\n
+ * "--budget MS": the budget for "auto", see Graph::setExactBudget\n
+ * "--estimate": only prints how many nodes and milliseconds the exact
+ * search is estimated to take, see Graph::estimateMaxClique\n
+ * "--explain": prints the graph's statistics and what the search is going
+ * to do about them on stderr first, see Graph::planMaxClique. Only the
+ * plain search and "--estimate" have a plan to print.\n
+ * "dot": it'll convert the output to DOT language\n
+ * "--threads N": the exact search runs on N threads (0 means one per core)\n
+ * "--time-limit MS", "--node-limit N": anytime search, prints the best
+ * clique found within the limits, and says on stderr if it's not proven
+ * maximum. Always exact and on one thread, so not with "approx", "auto" or
+ * "--threads".\n
+ * "--progress": with a limit, prints every improvement on stderr as it's
+ * found\n
+ * "--at-least K": only decides whether there's a clique of K vertices,
+ * and prints one if there is. Exact, so not with "approx", "auto",
+ * "--engine", "--explain", "--time-limit" or "--node-limit".\n
+ * "--top K": prints the K biggest maximal cliques instead, one per line as
+ * vertex lists (or as DOT subgraphs). Exact as well, so not with "approx",
+ * "auto", "--engine", "--explain", "--time-limit", "--node-limit" or
+ * "--at-least".\n
+ * "--engine NAME": which exact search to run, one of "auto" (the default),
+ * "branch-and-bound", "russian-doll", "complement" or "portfolio", see
+ * CliqueEngine\n
+ * "--hint V1,V2,...": a clique to start from, checked first, see the warm
+ * started Graph::maxClique\n
+ * "--order V1,V2,...": the order for the branch and bound to go through
+ * the vertices in, all of them exactly once\n
+ * Both work for the exact and the anytime search only, not with
+ * "--at-least", "--top", "--certificate", "--checkpoint" or "--resume".\n
+ * "--checkpoint FILE": the exact search saves its state to FILE every
+ * minute and at the end, see Graph::checkpointedCliques. Always exact and
+ * on one thread, so not with "approx", "auto", "--engine" or "--threads",
+ * and it's a search of its own, so not with "--top", "--at-least",
+ * "--time-limit", "--node-limit" or "--certificate" either.\n
+ * "--resume FILE": the exact search carries on from the state in FILE, and
+ * keeps saving there unless there's a "--checkpoint" too\n
+ * "--certificate FILE": the exact search also writes a proof that its
+ * clique is maximum to FILE, see Graph::certifiedMaxClique. Check it with
+ * verify_certificate. Not with "approx", "auto", "--at-least", "--top",
+ * "--time-limit" or "--node-limit", which wouldn't write one.
  *
- * @return 0, or 1 for parse errors
+ * @return 0, 1 for parse errors, options that don't go together, a bad
+ * hint or a bad state file, or 2 if "--at-least" found nothing
  */
 auto main(int argc, char* argv[]) -> int {
     auto args = span(argv, static_cast<size_t>(argc));
     if (argc < 2) {
-        cerr << "Usage: " << args[0] << " <filename> [approx] [dot]\n";
+        cerr << "Usage: " << args[0]
+             << " <filename> [approx|auto] [dot] [--budget MS] [--estimate]"
+                " [--explain] [--threads N] [--time-limit MS]"
+                " [--node-limit N] [--progress] [--at-least K] [--top K]"
+                " [--engine NAME] [--hint V1,V2,...] [--order V1,V2,...]"
+                " [--checkpoint FILE] [--resume FILE]"
+                " [--certificate FILE]\n";
         return 1;
     }
 
@@ -43,9 +124,161 @@ auto main(int argc, char* argv[]) -> int {
         return 1;
     }
 
-    AlgorithmAccuracy accuracy = (argc >= 3 && strcmp(args[2], "approx") == 0)
-                                     ? AlgorithmAccuracy::APPROXIMATE
-                                     : AlgorithmAccuracy::EXACT;
+    AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT;
+    bool dotLang = false;
+    size_t threadCount = 1;
+    SearchBudget budget;
+    bool progress = false;
+    std::optional<size_t> atLeast;
+    std::optional<size_t> top;
+    CliqueEngine engine = CliqueEngine::AUTO;
+    CliqueHint hint;
+    SearchCheckpoint checkpoint;
+    bool estimate = false;
+    bool explain = false;
+    std::string certificatePath;
+    try {
+        for (size_t i = 2; i < args.size(); ++i) {
+            bool hasValue = i + 1 < args.size();
+            if (strcmp(args[i], "approx") == 0) {
+                accuracy = AlgorithmAccuracy::APPROXIMATE;
+            } else if (strcmp(args[i], "exact") == 0) {
+                accuracy = AlgorithmAccuracy::EXACT;
+            } else if (strcmp(args[i], "auto") == 0) {
+                accuracy = AlgorithmAccuracy::AUTO;
+            } else if (strcmp(args[i], "dot") == 0) {
+                dotLang = true;
+            } else if (strcmp(args[i], "--estimate") == 0) {
+                estimate = true;
+            } else if (strcmp(args[i], "--explain") == 0) {
+                explain = true;
+            } else if (strcmp(args[i], "--budget") == 0 && hasValue) {
+                graph.setExactBudget(
+                    std::chrono::milliseconds{std::stoul(args[++i])});
+            } else if (strcmp(args[i], "--progress") == 0) {
+                progress = true;
+            } else if (strcmp(args[i], "--threads") == 0 && hasValue) {
+                threadCount = std::stoul(args[++i]);
+                if (threadCount == 0) {
+                    threadCount =
+                        std::max(std::thread::hardware_concurrency(), 1U);
+                }
+            } else if (strcmp(args[i], "--time-limit") == 0 && hasValue) {
+                budget.timeLimit =
+                    std::chrono::milliseconds{std::stoul(args[++i])};
+            } else if (strcmp(args[i], "--node-limit") == 0 && hasValue) {
+                budget.nodeLimit = std::stoul(args[++i]);
+            } else if (strcmp(args[i], "--at-least") == 0 && hasValue) {
+                atLeast = std::stoul(args[++i]);
+            } else if (strcmp(args[i], "--top") == 0 && hasValue) {
+                top = std::stoul(args[++i]);
+            } else if (strcmp(args[i], "--engine") == 0 && hasValue) {
+                auto found = parseCliqueEngine(args[++i]);
+                if (!found) {
+                    cerr << "Oops! [unknown engine: " << args[i] << "]\n";
+                    return 1;
+                }
+                engine = *found;
+            } else if (strcmp(args[i], "--hint") == 0 && hasValue) {
+                hint.clique = parseVertices(args[++i]);
+            } else if (strcmp(args[i], "--order") == 0 && hasValue) {
+                hint.order = parseVertices(args[++i]);
+            } else if (strcmp(args[i], "--checkpoint") == 0 && hasValue) {
+                checkpoint.savePath = args[++i];
+            } else if (strcmp(args[i], "--resume") == 0 && hasValue) {
+                checkpoint.resumePath = args[++i];
+            } else if (strcmp(args[i], "--certificate") == 0 && hasValue) {
+                certificatePath = args[++i];
+            } else {
+                cerr << "Oops! [unknown option: " << args[i] << "]\n";
+                return 1;
+            }
+        }
+    } catch (const exception& e) {
+        cerr << "Oops! [bad number: " << e.what() << "]\n";
+        return 1;
+    }
+
+    // The anytime search is the exact one, on this thread only
+    bool anytime = budget.timeLimit || budget.nodeLimit;
+    if (anytime && (accuracy != AlgorithmAccuracy::EXACT || threadCount > 1)) {
+        cerr << "Oops! [--time-limit and --node-limit can't be combined with"
+                " approx, auto or --threads]\n";
+        return 1;
+    }
+
+    // The top k search has its own bound and no plan, and prints a list
+    if (top && (accuracy != AlgorithmAccuracy::EXACT ||
+                engine != CliqueEngine::AUTO || explain || anytime ||
+                atLeast)) {
+        cerr << "Oops! [--top can't be combined with approx, auto, --engine,"
+                " --explain, --time-limit, --node-limit or --at-least]\n";
+        return 1;
+    }
+
+    // The decision search has its own branch and bound, and no plan
+    if (atLeast && (accuracy != AlgorithmAccuracy::EXACT ||
+                    engine != CliqueEngine::AUTO || explain || anytime)) {
+        cerr << "Oops! [--at-least can't be combined with approx, auto,"
+                " --engine, --explain, --time-limit or --node-limit]\n";
+        return 1;
+    }
+
+    // The checkpointed search is the plain branch and bound, on this thread
+    bool checkpointed =
+        !checkpoint.savePath.empty() || !checkpoint.resumePath.empty();
+    if (checkpointed &&
+        (accuracy != AlgorithmAccuracy::EXACT || threadCount > 1 ||
+         engine != CliqueEngine::AUTO || top || atLeast || anytime ||
+         !certificatePath.empty())) {
+        cerr << "Oops! [--checkpoint and --resume can't be combined with"
+                " approx, auto, --engine, --threads, --top, --at-least,"
+                " --time-limit, --node-limit or --certificate]\n";
+        return 1;
+    }
+
+    // The other searches have no way to start from a hint or an order
+    bool hinted = !hint.clique.empty() || !hint.order.empty();
+    if (hinted &&
+        (atLeast || top || !certificatePath.empty() || checkpointed)) {
+        cerr << "Oops! [--hint and --order can't be combined with"
+                " --at-least, --top, --certificate, --checkpoint or"
+                " --resume]\n";
+        return 1;
+    }
+
+    // Only a finished exact search proves anything, and the other ones
+    // would write no certificate at all
+    if (!certificatePath.empty() &&
+        (accuracy != AlgorithmAccuracy::EXACT || atLeast || top || anytime)) {
+        cerr << "Oops! [--certificate can't be combined with approx, auto,"
+                " --at-least, --top, --time-limit or --node-limit]\n";
+        return 1;
+    }
+
+    if (checkpoint.savePath.empty()) {
+        checkpoint.savePath = checkpoint.resumePath;
+    }
+
+    // The search hands over the plan it made, rather than making another
+    std::function<void(const SearchPlan&)> onPlan;
+    if (explain) {
+        onPlan = [](const SearchPlan& plan) { cerr << plan; };
+    }
+
+    if (estimate) {
+        if (onPlan) {
+            onPlan(graph.planMaxClique(accuracy, threadCount, engine));
+        }
+
+        auto found = graph.estimateMaxClique();
+        cout << "about " << static_cast<size_t>(found.nodes) << " nodes, "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    found.time)
+                    .count()
+             << "ms\n";
+        return 0;
+    }
 
 #ifdef DEBUG
     if (accuracy == AlgorithmAccuracy::APPROXIMATE) {
@@ -53,10 +286,67 @@ auto main(int argc, char* argv[]) -> int {
     }
 #endif
 
-    bool dotLang = ((argc >= 3 && strcmp("dot", args[2]) == 0) ||
-                    (argc >= 4 && strcmp("dot", args[3]) == 0));
+    if (top) {
+        // Vertex lists, since the subgraphs alone lose which vertices they
+        // came from
+        for (auto& clique : graph.topKCliques(*top, threadCount)) {
+            if (dotLang) {
+                cout << graph.subGraph(clique).toDotLang() << "\n";
+                continue;
+            }
+
+            for (size_t vertex : clique) {
+                cout << vertex << " ";
+            }
+            cout << "\n";
+        }
+        return 0;
+    }
 
-    auto maxClique = graph.maxCliqueGraph(accuracy);
+    Graph maxClique;
+    try {
+        if (atLeast) {
+            auto witness = graph.findCliqueOfSize(*atLeast, threadCount);
+            if (!witness) {
+                cerr << "No clique with " << *atLeast << " vertices\n";
+                return 2;
+            }
+            maxClique = graph.subGraph(*witness);
+        } else if (anytime) {
+            auto start = std::chrono::steady_clock::now();
+            auto found = graph.anytimeMaxClique(
+                budget, [&](const std::vector<size_t>& clique) {
+                    if (progress) {
+                        cerr << "size " << clique.size() << " after "
+                             << std::chrono::duration_cast<
+                                    std::chrono::milliseconds>(
+                                    std::chrono::steady_clock::now() - start)
+                                    .count()
+                             << "ms\n";
+                    }
+                },
+                hint);
+            if (!found.isOptimal) {
+                cerr << "Stopped after " << found.nodeCount
+                     << " nodes, clique might not be maximum\n";
+            }
+            maxClique = graph.subGraph(found.clique);
+        } else if (!certificatePath.empty()) {
+            auto certificate = graph.certifiedMaxClique(threadCount, engine);
+            clique::saveCertificate(certificate, certificatePath);
+            maxClique = graph.subGraph(certificate.clique);
+        } else if (!checkpoint.savePath.empty()) {
+            auto vertices = graph.maxClique(checkpoint);
+            maxClique = graph.subGraph(vertices);
+        } else {
+            auto vertices =
+                graph.maxClique(hint, accuracy, threadCount, engine, onPlan);
+            maxClique = graph.subGraph(vertices);
+        }
+    } catch (const exception& e) {
+        cerr << "Oops! [" << e.what() << "]\n";
+        return 1;
+    }
 
     if (dotLang) {
         cout << maxClique.toDotLang();
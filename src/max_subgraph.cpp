@@ -2,10 +2,15 @@
  * @file max_subgraph.cpp
  * @brief Tool to calculate maximum induced subgraph of two graphs
  */
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <exception>
+#include <functional>
 #include <iostream>
 #include <span>
+#include <string>
+#include <thread>
 
 #include "graph.hpp"
 
@@ -20,22 +25,39 @@ using std::span;
  * @param argc should be >=4
  * @param argv should have the filename to read at [1] and [2]\n
  * if either are "-", stdin will be read instead for that one\n
- * if [3] == "approx", an approximate algorithm will be used for the check
- * instead\n
- * if [4] is "dot", it'll convert the output to DOT language
+ * the rest are options, in any order:\n
+ * "approx": an approximate algorithm will be used for the check instead\n
+ * "exact": the default, the exact algorithm\n
+ * "auto": the exact algorithm if it's estimated to fit in the budget, the
+ * approximate one otherwise, see AlgorithmAccuracy::AUTO\n
+ * "--budget MS": the budget for "auto", see Graph::setExactBudget\n
+ * "--explain": prints the modular product's statistics and what the search
+ * is going to do about them on stderr first, see Graph::planMaxSubgraph.
+ * The checkpointed search has no plan to print.\n
+ * "dot": it'll convert the output to DOT language\n
+ * "--engine NAME": which exact search to run, "auto" (the default),
+ * "branch-and-bound" or "portfolio". The others max_clique takes can't
+ * keep ties, see Graph::modifiedMaxClique\n
+ * "--threads N": the exact search runs on N threads (0 means one per core)\n
+ * "--checkpoint FILE": the exact search saves its state to FILE every
+ * minute and at the end, see Graph::checkpointedCliques. Always exact and
+ * on one thread, so not with "approx", "auto", "--engine" or "--threads".\n
+ * "--resume FILE": the exact search carries on from the state in FILE, and
+ * keeps saving there unless there's a "--checkpoint" too
  *
- * @return 0, or 1 for parse errors
+ * @return 0, or 1 for parse errors, options that don't go together or a
+ * bad state file
  */
 auto main(int argc, char* argv[]) -> int {
     auto args = span(argv, static_cast<size_t>(argc));
     if (argc < 3) {
         cerr << "Usage: " << args[0]
-             << " <filename1> <filename2> [accuracy] [dot]\n";
+             << " <filename1> <filename2> [approx|auto] [dot]"
+                " [--engine NAME] [--budget MS] [--explain] [--threads N]"
+                " [--checkpoint FILE] [--resume FILE]\n";
         return 1;
     }
 
-    const int maxNumberOfArgs = 5;
-
     Graph lhs;
     Graph rhs;
     try {
@@ -46,13 +68,102 @@ auto main(int argc, char* argv[]) -> int {
         return 1;
     }
 
-    AlgorithmAccuracy accuracy = (argc >= 4 && strcmp(args[3], "approx") == 0)
-                                     ? AlgorithmAccuracy::APPROXIMATE
-                                     : AlgorithmAccuracy::EXACT;
+    AlgorithmAccuracy accuracy = AlgorithmAccuracy::EXACT;
+    bool dotLang = false;
+    CliqueEngine engine = CliqueEngine::AUTO;
+    size_t threadCount = 1;
+    SearchCheckpoint checkpoint;
+    bool explain = false;
+    for (size_t i = 3; i < args.size(); ++i) {
+        if (strcmp(args[i], "approx") == 0) {
+            accuracy = AlgorithmAccuracy::APPROXIMATE;
+        } else if (strcmp(args[i], "exact") == 0) {
+            accuracy = AlgorithmAccuracy::EXACT;
+        } else if (strcmp(args[i], "auto") == 0) {
+            accuracy = AlgorithmAccuracy::AUTO;
+        } else if (strcmp(args[i], "dot") == 0) {
+            dotLang = true;
+        } else if (strcmp(args[i], "--budget") == 0 && i + 1 < args.size()) {
+            try {
+                lhs.setExactBudget(
+                    std::chrono::milliseconds{std::stoul(args[++i])});
+            } catch (const exception& e) {
+                cerr << "Oops! [bad budget: " << e.what() << "]\n";
+                return 1;
+            }
+        } else if (strcmp(args[i], "--explain") == 0) {
+            explain = true;
+        } else if (strcmp(args[i], "--engine") == 0 && i + 1 < args.size()) {
+            auto found = parseCliqueEngine(args[++i]);
+            if (!found) {
+                cerr << "Oops! [unknown engine: " << args[i] << "]\n";
+                return 1;
+            }
+            engine = *found;
+        } else if (strcmp(args[i], "--threads") == 0 && i + 1 < args.size()) {
+            try {
+                threadCount = std::stoul(args[++i]);
+            } catch (const exception& e) {
+                cerr << "Oops! [bad thread count: " << e.what() << "]\n";
+                return 1;
+            }
+            if (threadCount == 0) {
+                threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+            }
+        } else if (strcmp(args[i], "--checkpoint") == 0 &&
+                   i + 1 < args.size()) {
+            checkpoint.savePath = args[++i];
+        } else if (strcmp(args[i], "--resume") == 0 && i + 1 < args.size()) {
+            checkpoint.resumePath = args[++i];
+        } else {
+            cerr << "Oops! [unknown option: " << args[i] << "]\n";
+            return 1;
+        }
+    }
+
+    // The tie-break needs every maximum clique, which only the branch and
+    // bound (or a portfolio of them) collects
+    if (engine == CliqueEngine::RUSSIAN_DOLL ||
+        engine == CliqueEngine::COMPLEMENT) {
+        cerr << "Oops! [--engine can only be auto, branch-and-bound or"
+                " portfolio here]\n";
+        return 1;
+    }
+
+    // The checkpointed search is the plain branch and bound, on this thread
+    bool checkpointed =
+        !checkpoint.savePath.empty() || !checkpoint.resumePath.empty();
+    if (checkpointed &&
+        (accuracy != AlgorithmAccuracy::EXACT || threadCount > 1 ||
+         engine != CliqueEngine::AUTO)) {
+        cerr << "Oops! [--checkpoint and --resume can't be combined with"
+                " approx, auto, --engine or --threads]\n";
+        return 1;
+    }
+
+    if (checkpoint.savePath.empty()) {
+        checkpoint.savePath = checkpoint.resumePath;
+    }
+
+    Graph maxSubgraph;
+    try {
+        // The search hands over the plan it made, rather than making
+        // another, and another modular product with it
+        std::function<void(const SearchPlan&)> onPlan;
+        if (explain) {
+            onPlan = [](const SearchPlan& plan) { cerr << plan; };
+        }
+
+        maxSubgraph = checkpoint.savePath.empty()
+                          ? lhs.maxSubgraph(rhs, accuracy, threadCount,
+                                            engine, onPlan)
+                          : lhs.maxSubgraph(rhs, checkpoint);
+    } catch (const exception& e) {
+        cerr << "Oops! [" << e.what() << "]\n";
+        return 1;
+    }
 
-    Graph maxSubgraph = lhs.maxSubgraph(rhs, accuracy);
-    if ((argc >= 4 && strcmp("dot", args[3]) == 0) ||
-        (argc >= maxNumberOfArgs && strcmp("dot", args[4]) == 0)) {
+    if (dotLang) {
         cout << maxSubgraph.toDotLang();
     } else {
         cout << maxSubgraph;
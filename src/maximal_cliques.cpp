@@ -0,0 +1,120 @@
+/**
+ * @file maximal_cliques.cpp
+ * @brief Tool to list every maximal clique of a .homenda.txt graph
+ */
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "graph.hpp"
+
+using std::cerr;
+using std::cout;
+using std::exception;
+using std::span;
+
+/**
+ * @brief Streams the maximal cliques of a graph
+ *
+ * Cliques are written as soon as they're found, so memory doesn't grow with
+ * how many there are.
+ *
+ * @param argc should be >=2
+ * @param argv should have the filename to read at [1]\n
+ * if it's "-", stdin will be read instead\n
+ * the rest are options, in any order:\n
+ * "--count": don't write the cliques, just count them\n
+ * "--binary FILE": write them to FILE instead of stdout, each one as a
+ * uint32 size followed by that many uint32 vertices, in native byte order\n
+ * Otherwise every clique goes on its own line of stdout, vertices sorted.
+ * The count and time taken go to stderr either way.
+ *
+ * @return 0, or 1 for parse errors and graphs with more than 2^32 - 1
+ * vertices
+ */
+auto main(int argc, char* argv[]) -> int {
+    // Before anything gets read, the graph might come from stdin
+    std::ios::sync_with_stdio(false);
+
+    auto args = span(argv, static_cast<size_t>(argc));
+    if (argc < 2) {
+        cerr << "Usage: " << args[0]
+             << " <filename> [--count] [--binary FILE]\n";
+        return 1;
+    }
+
+    Graph graph;
+    try {
+        graph = Graph::fromFilename(args[1]);
+    } catch (const exception& e) {
+        cerr << "Oops! [" << e.what() << "]\n";
+        return 1;
+    }
+
+    bool countOnly = false;
+    std::ofstream binary;
+    for (size_t i = 2; i < args.size(); ++i) {
+        if (strcmp(args[i], "--count") == 0) {
+            countOnly = true;
+        } else if (strcmp(args[i], "--binary") == 0 && i + 1 < args.size()) {
+            binary.open(args[++i], std::ios::binary);
+            if (!binary) {
+                cerr << "Oops! [can't write to " << args[i] << "]\n";
+                return 1;
+            }
+        } else {
+            cerr << "Oops! [unknown option: " << args[i] << "]\n";
+            return 1;
+        }
+    }
+
+    // Vertices get written as uint32, so they have to fit
+    if (graph.getVertexCount() > std::numeric_limits<std::uint32_t>::max()) {
+        cerr << "Oops! [too many vertices for 32-bit output]\n";
+        return 1;
+    }
+
+    // Reused for every clique, so nothing gets allocated per clique
+    std::vector<std::uint32_t> sorted;
+    sorted.reserve(graph.getVertexCount());
+    auto writeBinary = [&](std::uint32_t value) {
+        auto bytes = std::bit_cast<std::array<char, sizeof(value)>>(value);
+        binary.write(bytes.data(), bytes.size());
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    size_t count = graph.forEachMaximalClique([&](span<const size_t> clique) {
+        if (countOnly) {
+            return;
+        }
+
+        sorted.assign(clique.begin(), clique.end());
+        std::ranges::sort(sorted);
+        if (binary.is_open()) {
+            writeBinary(static_cast<std::uint32_t>(sorted.size()));
+            for (std::uint32_t vertex : sorted) {
+                writeBinary(vertex);
+            }
+            return;
+        }
+
+        for (std::uint32_t vertex : sorted) {
+            cout << vertex << ' ';
+        }
+        cout << '\n';
+    });
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    cout.flush();
+    cerr << count << " maximal cliques in " << elapsed.count() << "ms\n";
+}
@@ -22,7 +22,7 @@ using std::span;
  * if either are "-", stdin will be read instead for that one\n
  * if [3] is "dot", it'll convert the output to DOT language
  *
- * @return 0, or 1 for parse errors
+ * @return 0, or 1 for parse errors and negative edge weights
  */
 auto main(int argc, char* argv[]) -> int {
     auto args = span(argv, static_cast<size_t>(argc));
@@ -31,17 +31,16 @@ auto main(int argc, char* argv[]) -> int {
         return 1;
     }
 
-    Graph lhs;
-    Graph rhs;
+    Graph modProduct;
     try {
-        lhs = Graph::fromFilename(args[1]);
-        rhs = Graph::fromFilename(args[2]);
+        Graph lhs = Graph::fromFilename(args[1]);
+        Graph rhs = Graph::fromFilename(args[2]);
+        modProduct = lhs.modularProduct(rhs);
     } catch (const exception& e) {
         cerr << "Oops! [" << e.what() << "]\n";
         return 1;
     }
 
-    Graph modProduct = lhs.modularProduct(rhs);
     if (argc < 4 || strcmp("dot", args[3]) != 0) {
         cout << modProduct;
     } else {
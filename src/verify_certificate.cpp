@@ -0,0 +1,52 @@
+/**
+ * @file verify_certificate.cpp
+ * @brief Tool to check max clique certificates against .homenda.txt graphs
+ */
+#include <exception>
+#include <iostream>
+#include <span>
+
+#include "graph.hpp"
+
+using std::cerr;
+using std::cout;
+using std::exception;
+using std::span;
+
+/**
+ * @brief Certificate checker
+ *
+ * Takes a graph and a certificate from "max_clique --certificate", and
+ * checks that the certificate's clique is a maximum clique of the graph,
+ * without searching for one, see Graph::verifyMaxClique
+ *
+ * @param argc should be 3
+ * @param argv should have the graph's filename at [1], "-" for stdin, and
+ * the certificate's at [2]
+ *
+ * @return 0 if it checks out, 1 for parse errors, or 2 if it doesn't
+ */
+auto main(int argc, char* argv[]) -> int {
+    auto args = span(argv, static_cast<size_t>(argc));
+    if (argc != 3) {
+        cerr << "Usage: " << args[0] << " <filename> <certificate>\n";
+        return 1;
+    }
+
+    Graph graph;
+    clique::CliqueCertificate certificate;
+    try {
+        graph = Graph::fromFilename(args[1]);
+        certificate = clique::loadCertificate(args[2]);
+    } catch (const exception& e) {
+        cerr << "Oops! [" << e.what() << "]\n";
+        return 1;
+    }
+
+    if (!graph.verifyMaxClique(certificate)) {
+        cout << "NOT verified.\n";
+        return 2;
+    }
+    cout << "Verified, max clique has " << certificate.clique.size()
+         << " vertices.\n";
+}
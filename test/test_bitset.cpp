@@ -0,0 +1,79 @@
+#include <random>
+#include <vector>
+
+#include "bitset.hpp"
+#include "catch_amalgamated.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+TEST_CASE("Every available kernel agrees with the scalar one") {
+    std::mt19937_64 generator{42};
+    auto tables = bits::availableKernels();
+    const auto& scalar = tables.front();
+    REQUIRE(scalar.level == bits::KernelLevel::SCALAR);
+
+    // Odd lengths, so the SIMD tails get exercised too
+    for (size_t length : {0, 1, 3, 4, 7, 8, 9, 16, 17, 37}) {
+        std::vector<bits::Word> lhs(length);
+        std::vector<bits::Word> rhs(length);
+        for (size_t i = 0; i < length; ++i) {
+            lhs[i] = generator();
+            rhs[i] = generator();
+        }
+
+        std::vector<bits::Word> expectedAnd(length);
+        std::vector<bits::Word> expectedAndNot(length);
+        scalar.intersect(lhs, rhs, expectedAnd);
+        scalar.andNot(lhs, rhs, expectedAndNot);
+
+        for (const auto& table : tables) {
+            DYNAMIC_SECTION(bits::kernelLevelName(table.level)
+                            << " on " << length << " words") {
+                std::vector<bits::Word> out(length);
+                table.intersect(lhs, rhs, out);
+                REQUIRE(out == expectedAnd);
+
+                table.andNot(lhs, rhs, out);
+                REQUIRE(out == expectedAndNot);
+
+                REQUIRE(table.intersectCount(lhs, rhs) ==
+                        scalar.count(expectedAnd));
+                REQUIRE(table.count(lhs) == scalar.count(lhs));
+
+                // Writing over an input is allowed
+                out = lhs;
+                table.intersect(out, rhs, out);
+                REQUIRE(out == expectedAnd);
+            }
+        }
+    }
+}
+
+TEST_CASE("Single bit helpers") {
+    bits::BitMatrix matrix{70};
+    REQUIRE(matrix.getStride() == 2);
+
+    matrix.set(3, 0);
+    matrix.set(3, 64);
+    matrix.set(3, 69);
+
+    REQUIRE(matrix.test(3, 64));
+    REQUIRE_FALSE(matrix.test(2, 64));
+    REQUIRE(bits::count(matrix[3]) == 3);
+
+    REQUIRE(bits::nextSet(matrix[3], 0) == 0);
+    REQUIRE(bits::nextSet(matrix[3], 1) == 64);
+    REQUIRE(bits::nextSet(matrix[3], 65) == 69);
+    REQUIRE(bits::nextSet(matrix[3], 70) == 2 * bits::WORD_BITS);
+
+    bits::reset(matrix[3], 64);
+    REQUIRE(bits::nextSet(matrix[3], 1) == 69);
+    REQUIRE(bits::none(matrix[0]));
+    REQUIRE_FALSE(bits::none(matrix[3]));
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,169 @@
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "certificate.hpp"
+#include "graph.hpp"
+#include "test_graphs.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+// The first node closed by a coloring with 2 colors or more, preorder
+auto firstColoring(clique::ProofNode& node) -> clique::ProofNode* {
+    if (node.coloring.size() >= 2) {
+        return &node;
+    }
+    for (auto& child : node.children) {
+        if (auto* found = firstColoring(child)) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+// Somewhere to put certificates that's cleaned up after
+class CertificateFile {
+   private:
+    std::string path;
+
+   public:
+    explicit CertificateFile(const std::string& name)
+        : path{(std::filesystem::temp_directory_path() / name).string()} {
+        std::filesystem::remove(path);
+    }
+    CertificateFile(const CertificateFile&) = delete;
+    CertificateFile(CertificateFile&&) = delete;
+    auto operator=(const CertificateFile&) -> CertificateFile& = delete;
+    auto operator=(CertificateFile&&) -> CertificateFile& = delete;
+    ~CertificateFile() { std::filesystem::remove(path); }
+
+    [[nodiscard]] auto get() const -> const std::string& { return path; }
+};
+
+}  // namespace
+
+TEST_CASE("Certified max cliques") {
+    SECTION("Random graphs verify") {
+        for (unsigned seed : {1, 2, 3, 4}) {
+            for (double density : {0.2, 0.5, 0.8}) {
+                Graph graph{randomMatrix(35, density, seed)};
+                auto certificate = graph.certifiedMaxClique();
+
+                REQUIRE(certificate.clique.size() == graph.maxClique().size());
+                REQUIRE(graph.verifyMaxClique(certificate));
+            }
+        }
+    }
+
+    SECTION("Any engine's clique gets a proof") {
+        Graph graph{randomMatrix(40, 0.6, 5)};
+        for (auto engine :
+             {CliqueEngine::RUSSIAN_DOLL, CliqueEngine::COMPLEMENT}) {
+            REQUIRE(graph.verifyMaxClique(graph.certifiedMaxClique(1, engine)));
+        }
+        REQUIRE(graph.verifyMaxClique(graph.certifiedMaxClique(2)));
+    }
+
+    SECTION("Small cases") {
+        REQUIRE(Graph{}.verifyMaxClique(Graph{}.certifiedMaxClique()));
+
+        auto edgeless = toBits(randomMatrix(6, 0, 7));
+        auto certificate = clique::certifyClique(edgeless, {3});
+        REQUIRE(clique::verifyCertificate(edgeless, certificate));
+    }
+
+    SECTION("Survive a round trip") {
+        CertificateFile file{"test_certificate.txt"};
+        Graph graph{randomMatrix(30, 0.5, 11)};
+        auto certificate = graph.certifiedMaxClique();
+        clique::saveCertificate(certificate, file.get());
+
+        auto loaded = clique::loadCertificate(file.get());
+        REQUIRE(loaded.vertexCount == certificate.vertexCount);
+        REQUIRE(loaded.fingerprint == certificate.fingerprint);
+        REQUIRE(loaded.clique == certificate.clique);
+        REQUIRE(graph.verifyMaxClique(loaded));
+
+        REQUIRE_THROWS_AS(clique::loadCertificate(file.get() + ".missing"),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("Bad certificates") {
+    auto matrix = randomMatrix(30, 0.5, 13);
+    auto adjacency = toBits(matrix);
+    auto certificate = Graph{randomMatrix(30, 0.5, 13)}.certifiedMaxClique();
+    REQUIRE(clique::verifyCertificate(adjacency, certificate));
+
+    SECTION("Not maximum") {
+        auto smaller = certificate.clique;
+        smaller.pop_back();
+        REQUIRE_THROWS_AS(clique::certifyClique(adjacency, smaller),
+                          std::invalid_argument);
+
+        auto tampered = certificate;
+        tampered.clique.pop_back();
+        REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+    }
+
+    SECTION("Not a clique") {
+        std::vector<size_t> everything(30);
+        for (size_t vertex = 0; vertex < everything.size(); ++vertex) {
+            everything[vertex] = vertex;
+        }
+        REQUIRE_THROWS_AS(clique::certifyClique(adjacency, everything),
+                          std::invalid_argument);
+
+        auto tampered = certificate;
+        tampered.clique = everything;
+        REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+    }
+
+    SECTION("Broken coloring") {
+        auto tampered = certificate;
+        auto* node = firstColoring(tampered.proof);
+        REQUIRE(node != nullptr);
+
+        SECTION("Missing a vertex") {
+            node->coloring.front().pop_back();
+            REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+        }
+
+        SECTION("Too many colors") {
+            // More than any budget in a graph this size
+            node->coloring.resize(node->coloring.size() + 30);
+            REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+        }
+
+        SECTION("Adjacent vertices sharing a color") {
+            auto merged = node->coloring.back();
+            node->coloring.pop_back();
+            node->coloring.front().insert(node->coloring.front().end(),
+                                          merged.begin(), merged.end());
+            REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+        }
+    }
+
+    SECTION("Branches cut short") {
+        auto tampered = certificate;
+        tampered.proof = {};
+        REQUIRE_FALSE(clique::verifyCertificate(adjacency, tampered));
+    }
+
+    SECTION("Another graph") {
+        auto other = toBits(randomMatrix(30, 0.5, 17));
+        REQUIRE_FALSE(clique::verifyCertificate(other, certificate));
+        REQUIRE_FALSE(
+            Graph{randomMatrix(30, 0.5, 17)}.verifyMaxClique(certificate));
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
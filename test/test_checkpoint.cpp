@@ -0,0 +1,214 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "checkpoint.hpp"
+#include "graph.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+auto randomGraph(size_t vertexCount, double density, unsigned seed,
+                 bool directed) -> Graph {
+    std::mt19937 generator{seed};
+    std::bernoulli_distribution edge{density};
+    std::uniform_int_distribution multiplicity{1, 3};
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = directed ? 0 : i + 1; j < vertexCount; ++j) {
+            if (i == j || !edge(generator)) {
+                continue;
+            }
+            matrix[i][j] = directed ? multiplicity(generator) : 1;
+            if (!directed) {
+                matrix[j][i] = 1;
+            }
+        }
+    }
+    return Graph{std::move(matrix)};
+}
+
+// Somewhere to put states that's cleaned up after
+class StateFile {
+   private:
+    std::string path;
+
+   public:
+    explicit StateFile(const std::string& name)
+        : path{(std::filesystem::temp_directory_path() / name).string()} {
+        std::filesystem::remove(path);
+    }
+    StateFile(const StateFile&) = delete;
+    StateFile(StateFile&&) = delete;
+    auto operator=(const StateFile&) -> StateFile& = delete;
+    auto operator=(StateFile&&) -> StateFile& = delete;
+    ~StateFile() { std::filesystem::remove(path); }
+
+    [[nodiscard]] auto get() const -> const std::string& { return path; }
+};
+
+}  // namespace
+
+TEST_CASE("Search states") {
+    StateFile file{"test_checkpoint_state.txt"};
+
+    SECTION("Survive a round trip") {
+        clique::SearchState state{"max-clique",
+                                  5,
+                                  0xDEADBEEF,
+                                  {{0, 3, 4}},
+                                  {{{}, {0, 1, 2, 3, 4}}, {{1}, {2, 4}}}};
+        clique::saveState(state, file.get());
+        auto loaded = clique::loadState(file.get());
+
+        REQUIRE(loaded.kind == state.kind);
+        REQUIRE(loaded.vertexCount == state.vertexCount);
+        REQUIRE(loaded.fingerprint == state.fingerprint);
+        REQUIRE(loaded.incumbents == state.incumbents);
+        REQUIRE(loaded.frontier.size() == state.frontier.size());
+        for (size_t i = 0; i < state.frontier.size(); ++i) {
+            REQUIRE(loaded.frontier[i].clique == state.frontier[i].clique);
+            REQUIRE(loaded.frontier[i].candidates ==
+                    state.frontier[i].candidates);
+        }
+        REQUIRE_FALSE(std::filesystem::exists(file.get() + ".tmp"));
+    }
+
+    SECTION("Bad files get turned down") {
+        REQUIRE_THROWS_AS(clique::loadState(file.get()),
+                          std::invalid_argument);
+
+        std::ofstream{file.get()} << "3\n0 1 1\n1 0 1\n1 1 0\n";
+        REQUIRE_THROWS_AS(clique::loadState(file.get()),
+                          std::invalid_argument);
+
+        std::ofstream{file.get()} << "clique-search-state 1\n"
+                                     "max-clique 2 0\n"
+                                     "0\n"
+                                     "1\n"
+                                     "1 7 0\n";
+        REQUIRE_THROWS_AS(clique::loadState(file.get()),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("Checkpointed clique search") {
+    StateFile file{"test_checkpoint_search.txt"};
+
+    // No time between saves, so it gets interrupted every few dozen nodes
+    SearchCheckpoint everyFewNodes{file.get(), "",
+                                   std::chrono::milliseconds{0}};
+
+    for (size_t vertexCount : {0, 1, 40, 90}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            Graph graph = randomGraph(vertexCount, 0.6, 13, false);
+            REQUIRE(graph.maxClique(everyFewNodes) == graph.maxClique());
+
+            // What's left of a finished search is just the answer
+            auto finished = clique::loadState(file.get());
+            REQUIRE(finished.frontier.empty());
+            REQUIRE(finished.incumbents ==
+                    std::vector<std::vector<size_t>>{graph.maxClique()});
+            REQUIRE(graph.maxClique({"", file.get(), {}}) ==
+                    graph.maxClique());
+        }
+    }
+
+    SECTION("Resuming halfway") {
+        Graph graph = randomGraph(70, 0.6, 17, false);
+        REQUIRE_FALSE(graph.maxClique(everyFewNodes).empty());
+
+        // Same as a search that got as far as the root's children, with
+        // nothing found yet
+        auto state = clique::loadState(file.get());
+        state.incumbents.clear();
+        for (size_t vertex = 70; vertex-- > 0;) {
+            clique::FrontierTask child{{vertex}, {}};
+            for (size_t other = vertex + 1; other < 70; ++other) {
+                if (graph[vertex][other] > 0) {
+                    child.candidates.push_back(other);
+                }
+            }
+            state.frontier.push_back(child);
+        }
+        clique::saveState(state, file.get());
+
+        REQUIRE(graph.maxClique({file.get(), file.get(), {}}) ==
+                graph.maxClique());
+        REQUIRE(clique::loadState(file.get()).frontier.empty());
+    }
+
+    SECTION("Multigraphs and subgraphs") {
+        Graph graph = randomGraph(40, 0.35, 19, true);
+        auto heaviest = graph.modifiedMaxClique();
+        REQUIRE(graph.modifiedMaxClique(everyFewNodes) == heaviest);
+
+        // Only the winner of the tie-break gets saved, not every tie
+        REQUIRE(clique::loadState(file.get()).incumbents ==
+                std::vector<std::vector<size_t>>{heaviest});
+
+        Graph lhs = randomGraph(6, 0.5, 23, true);
+        Graph rhs = randomGraph(5, 0.5, 29, true);
+        std::stringstream checkpointed;
+        std::stringstream plain;
+        checkpointed << lhs.maxSubgraph(rhs, everyFewNodes);
+        plain << lhs.maxSubgraph(rhs);
+        REQUIRE(checkpointed.str() == plain.str());
+    }
+
+    SECTION("States only resume the search that saved them") {
+        Graph graph = randomGraph(30, 0.5, 31, false);
+        Graph other = randomGraph(30, 0.5, 37, false);
+        REQUIRE_FALSE(graph.maxClique(everyFewNodes).empty());
+
+        REQUIRE_THROWS_AS(other.maxClique({"", file.get(), {}}),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(graph.modifiedMaxClique({"", file.get(), {}}),
+                          std::invalid_argument);
+    }
+
+    SECTION("States that don't hold up get turned down") {
+        Graph graph = randomGraph(30, 0.5, 41, false);
+        REQUIRE_FALSE(graph.maxClique(everyFewNodes).empty());
+        auto saved = clique::loadState(file.get());
+
+        // Two vertices that aren't adjacent, and one twice
+        size_t lonely = 1;
+        while (graph[0][lonely] > 0) {
+            ++lonely;
+        }
+        for (const auto& bad :
+             {std::vector<size_t>{0, lonely}, std::vector<size_t>{3, 3}}) {
+            auto state = saved;
+            state.incumbents = {bad};
+            clique::saveState(state, file.get());
+            REQUIRE_THROWS_AS(graph.maxClique({"", file.get(), {}}),
+                              std::invalid_argument);
+
+            state = saved;
+            state.frontier = {{bad, {}}};
+            clique::saveState(state, file.get());
+            REQUIRE_THROWS_AS(graph.maxClique({"", file.get(), {}}),
+                              std::invalid_argument);
+
+            state.frontier = {{{bad.front()}, {bad.back()}}};
+            clique::saveState(state, file.get());
+            REQUIRE_THROWS_AS(graph.maxClique({"", file.get(), {}}),
+                              std::invalid_argument);
+        }
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,130 @@
+#include <cstdint>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "clique_counting.hpp"
+#include "graph.hpp"
+#include "maximal_cliques.hpp"
+#include "test_graphs.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+// Every vertex adjacent to the next `reach` around a cycle, so there are
+// vertexCount * (reach choose k - 1) cliques of size k, for k up to
+// reach + 1, as long as the cycle is long enough
+auto circulant(size_t vertexCount, size_t reach)
+    -> std::vector<std::vector<size_t>> {
+    std::vector<std::vector<size_t>> neighbours(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        for (size_t step = 1; step <= reach; ++step) {
+            size_t other = (vertex + step) % vertexCount;
+            neighbours[vertex].push_back(other);
+            neighbours[other].push_back(vertex);
+        }
+    }
+    return neighbours;
+}
+
+auto choose(size_t n, size_t k) -> std::uint64_t {
+    std::uint64_t result = 1;
+    for (size_t i = 0; i < k; ++i) {
+        result = result * (n - i) / (i + 1);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Clique counting") {
+    SECTION("Same as listing them") {
+        for (unsigned seed : {1, 2, 3}) {
+            for (double density : {0.2, 0.5, 0.8}) {
+                Graph graph{randomMatrix(25, density, seed)};
+                auto counts = graph.countCliques(6);
+                REQUIRE(counts.size() == 7);
+
+                for (size_t size = 0; size <= 6; ++size) {
+                    std::vector<std::uint64_t> perVertex(25);
+                    std::uint64_t total = 0;
+                    for (const auto& clique : graph.cliquesOfSize(size)) {
+                        ++total;
+                        for (size_t vertex : clique) {
+                            ++perVertex[vertex];
+                        }
+                    }
+                    REQUIRE(counts[size].total == total);
+                    REQUIRE(counts[size].perVertex == perVertex);
+                }
+            }
+        }
+    }
+
+    SECTION("Threads don't change anything") {
+        Graph graph{randomMatrix(60, 0.4, 7)};
+        auto counts = graph.countCliques(8);
+        for (size_t threadCount : {0, 2, 4}) {
+            auto threaded = graph.countCliques(8, threadCount);
+            for (size_t size = 0; size <= 8; ++size) {
+                REQUIRE(threaded[size].total == counts[size].total);
+                REQUIRE(threaded[size].perVertex == counts[size].perVertex);
+            }
+        }
+    }
+
+    SECTION("Small cases") {
+        auto empty = clique::countCliques({}, 3);
+        REQUIRE(empty[0].total == 1);
+        REQUIRE(empty[1].total == 0);
+        REQUIRE(empty[3].perVertex.empty());
+
+        auto nothing = clique::countCliques(circulant(5, 1), 0);
+        REQUIRE(nothing.size() == 1);
+        REQUIRE(nothing[0].total == 1);
+
+        // A 5-cycle has edges but no triangles
+        auto cycle = clique::countCliques(circulant(5, 1), 3);
+        REQUIRE(cycle[1].total == 5);
+        REQUIRE(cycle[2].total == 5);
+        REQUIRE(cycle[2].perVertex == std::vector<std::uint64_t>(5, 2));
+        REQUIRE(cycle[3].total == 0);
+    }
+
+    SECTION("Big and sparse") {
+        constexpr size_t VERTICES = 100000;
+        constexpr size_t REACH = 4;
+        auto counts = clique::countCliques(circulant(VERTICES, REACH), 6, 2);
+
+        for (size_t size = 1; size <= 6; ++size) {
+            std::uint64_t each = choose(REACH, size - 1);
+            REQUIRE(counts[size].total == VERTICES * each);
+            REQUIRE(counts[size].perVertex ==
+                    std::vector<std::uint64_t>(VERTICES, size * each));
+        }
+    }
+}
+
+TEST_CASE("Degeneracy order on lists") {
+    for (unsigned seed : {1, 2, 3}) {
+        auto matrix = randomMatrix(40, 0.3, seed);
+        bits::BitMatrix adjacency{40};
+        std::vector<std::vector<size_t>> neighbours(40);
+        for (size_t i = 0; i < 40; ++i) {
+            for (size_t j = 0; j < 40; ++j) {
+                if (matrix[i][j] != 0) {
+                    adjacency.set(i, j);
+                    neighbours[i].push_back(j);
+                }
+            }
+        }
+        REQUIRE(clique::degeneracyOrder(neighbours) ==
+                clique::degeneracyOrder(adjacency));
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
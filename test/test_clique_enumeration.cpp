@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "maximal_cliques.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+using Cliques = std::vector<std::vector<size_t>>;
+
+// Random directed multigraph, some edges only go one way
+auto randomDirectedMatrix(size_t vertexCount, double density, unsigned seed)
+    -> std::vector<std::vector<int>> {
+    std::mt19937 generator{seed};
+    std::bernoulli_distribution edge{density};
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = 0; j < vertexCount; ++j) {
+            matrix[i][j] = static_cast<int>(i != j && edge(generator));
+        }
+    }
+    return matrix;
+}
+
+// Every subset, checked by hand
+auto bruteForce(const std::vector<std::vector<int>>& matrix, bool maximal,
+                size_t size) -> Cliques {
+    size_t vertexCount = matrix.size();
+    auto mutual = [&](size_t i, size_t j) {
+        return matrix[i][j] != 0 && matrix[j][i] != 0;
+    };
+
+    Cliques found;
+    for (size_t subset = 0; subset < (size_t{1} << vertexCount); ++subset) {
+        std::vector<size_t> members;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if ((subset >> vertex & 1U) != 0) {
+                members.push_back(vertex);
+            }
+        }
+
+        bool isClique = std::ranges::all_of(members, [&](size_t i) {
+            return std::ranges::all_of(
+                members, [&](size_t j) { return i == j || mutual(i, j); });
+        });
+        if (!isClique || (!maximal && members.size() != size)) {
+            continue;
+        }
+
+        if (maximal) {
+            bool extends = false;
+            for (size_t other = 0; other < vertexCount; ++other) {
+                extends |= std::ranges::find(members, other) == members.end() &&
+                           std::ranges::all_of(members, [&](size_t i) {
+                               return mutual(i, other);
+                           });
+            }
+            if (extends) {
+                continue;
+            }
+        }
+
+        found.push_back(members);
+    }
+
+    std::ranges::sort(found);
+    return found;
+}
+
+auto collect(Generator<std::vector<size_t>> cliques) -> Cliques {
+    Cliques found;
+    for (const auto& clique : cliques) {
+        found.push_back(clique);
+    }
+    return found;
+}
+
+}  // namespace
+
+TEST_CASE("Maximal clique enumeration") {
+    SECTION("Matches brute force, in lexicographic order") {
+        for (unsigned seed = 0; seed < 20; ++seed) {
+            auto matrix = randomDirectedMatrix(11, 0.7, seed);
+            Graph graph{std::vector{matrix}};
+
+            auto found = collect(graph.maximalCliques());
+            REQUIRE(std::ranges::is_sorted(found));
+            REQUIRE(found == bruteForce(matrix, true, 0));
+        }
+    }
+
+    SECTION("The biggest ones are the maximum cliques") {
+        Graph graph{randomDirectedMatrix(40, 0.8, 5)};
+
+        Cliques biggest;
+        for (const auto& clique : graph.maximalCliques()) {
+            if (!biggest.empty() && clique.size() < biggest.front().size()) {
+                continue;
+            }
+            if (!biggest.empty() && clique.size() > biggest.front().size()) {
+                biggest.clear();
+            }
+            biggest.push_back(clique);
+        }
+        REQUIRE(biggest == graph.allMaxCliques());
+    }
+
+    SECTION("Stopping early") {
+        // Every vertex is its own maximal clique here
+        Graph graph{std::istringstream{"4\n"
+                                       "0 0 0 0\n"
+                                       "0 0 0 0\n"
+                                       "0 0 0 0\n"
+                                       "0 0 0 0"}};
+        Cliques found;
+        for (const auto& clique : graph.maximalCliques()) {
+            found.push_back(clique);
+            if (found.size() == 2) {
+                break;
+            }
+        }
+        REQUIRE(found == Cliques{{0}, {1}});
+    }
+
+    SECTION("Empty graph") {
+        Graph graph{std::istringstream{"0\n"}};
+        REQUIRE(collect(graph.maximalCliques()) == Cliques{{}});
+    }
+}
+
+TEST_CASE("Fixed size clique enumeration") {
+    SECTION("Matches brute force, in lexicographic order") {
+        for (unsigned seed = 0; seed < 10; ++seed) {
+            auto matrix = randomDirectedMatrix(10, 0.75, seed);
+            Graph graph{std::vector{matrix}};
+
+            for (size_t size = 0; size <= 11; ++size) {
+                auto found = collect(graph.cliquesOfSize(size));
+                REQUIRE(std::ranges::is_sorted(found));
+                REQUIRE(found == bruteForce(matrix, false, size));
+            }
+        }
+    }
+
+    SECTION("Triangles of K4") {
+        Graph graph{std::istringstream{"4\n"
+                                       "0 1 1 1\n"
+                                       "1 0 1 1\n"
+                                       "1 1 0 1\n"
+                                       "1 1 1 0"}};
+        REQUIRE(collect(graph.cliquesOfSize(3)) ==
+                Cliques{{0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}});
+        REQUIRE(collect(graph.cliquesOfSize(0)) == Cliques{{}});
+        REQUIRE(collect(graph.cliquesOfSize(5)).empty());
+    }
+
+    SECTION("Generators can be moved around") {
+        Graph graph{randomDirectedMatrix(30, 0.5, 3)};
+        auto pairs = graph.cliquesOfSize(2);
+        auto moved = std::move(pairs);
+        size_t count = 0;
+        for ([[maybe_unused]] const auto& clique : moved) {
+            ++count;
+        }
+        REQUIRE(count == collect(graph.cliquesOfSize(2)).size());
+        REQUIRE(count > 0);
+    }
+}
+
+TEST_CASE("Streaming maximal clique enumeration") {
+    auto streamed = [](const Graph& graph) {
+        Cliques found;
+        size_t count =
+            graph.forEachMaximalClique([&](std::span<const size_t> clique) {
+                found.emplace_back(clique.begin(), clique.end());
+                std::ranges::sort(found.back());
+            });
+        REQUIRE(count == found.size());
+        std::ranges::sort(found);
+        return found;
+    };
+
+    SECTION("Same cliques as the lexicographic enumeration") {
+        // Dense graphs have exponentially many maximal cliques, keep them
+        // small enough that listing them twice takes no time
+        for (unsigned seed = 0; seed < 4; ++seed) {
+            for (double density : {0.1, 0.5, 0.9}) {
+                Graph graph{randomDirectedMatrix(density > 0.7 ? 40 : 60,
+                                                 density, seed)};
+                REQUIRE(streamed(graph) == collect(graph.maximalCliques()));
+            }
+        }
+    }
+
+    SECTION("Isolated vertices and the empty graph") {
+        Graph graph{std::istringstream{"3\n"
+                                       "0 1 0\n"
+                                       "1 0 0\n"
+                                       "0 0 0"}};
+        REQUIRE(streamed(graph) == Cliques{{0, 1}, {2}});
+        REQUIRE(streamed(Graph{std::istringstream{"0\n"}}) == Cliques{{}});
+    }
+}
+
+TEST_CASE("Degeneracy order") {
+    // Every vertex should have at most degeneracy-many neighbours after it
+    auto laterNeighbours = [](const bits::BitMatrix& adjacency) {
+        auto order = clique::degeneracyOrder(adjacency);
+        std::vector<size_t> position(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            position[order[i]] = i;
+        }
+        REQUIRE(std::ranges::is_permutation(
+            order, std::views::iota(size_t{0}, order.size())));
+
+        size_t most = 0;
+        for (size_t vertex = 0; vertex < order.size(); ++vertex) {
+            size_t later = 0;
+            for (size_t other = 0; other < order.size(); ++other) {
+                later += static_cast<size_t>(
+                    bits::test(adjacency[vertex], other) &&
+                    position[other] > position[vertex]);
+            }
+            most = std::max(most, later);
+        }
+        return most;
+    };
+
+    SECTION("A tree is 1-degenerate") {
+        constexpr size_t vertexCount = 50;
+        bits::BitMatrix tree{vertexCount};
+        for (size_t vertex = 1; vertex < vertexCount; ++vertex) {
+            bits::set(tree[vertex], vertex / 2);
+            bits::set(tree[vertex / 2], vertex);
+        }
+        REQUIRE(laterNeighbours(tree) == 1);
+    }
+
+    SECTION("A complete graph is (n-1)-degenerate") {
+        constexpr size_t vertexCount = 9;
+        bits::BitMatrix complete{vertexCount};
+        for (size_t i = 0; i < vertexCount; ++i) {
+            for (size_t j = 0; j < vertexCount; ++j) {
+                if (i != j) {
+                    bits::set(complete[i], j);
+                }
+            }
+        }
+        REQUIRE(laterNeighbours(complete) == vertexCount - 1);
+    }
+
+    SECTION("A hub with a triangle hanging off") {
+        // Star around 0, plus the triangle 1, 2, 3: max degree 5, but
+        // degeneracy 2
+        bits::BitMatrix adjacency{6};
+        auto edge = [&](size_t i, size_t j) {
+            bits::set(adjacency[i], j);
+            bits::set(adjacency[j], i);
+        };
+        for (size_t leaf = 1; leaf < 6; ++leaf) {
+            edge(0, leaf);
+        }
+        edge(1, 2);
+        edge(2, 3);
+        REQUIRE(laterNeighbours(adjacency) == 2);
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bitset.hpp"
+
+// Graphs shared by the tests. Only the test binaries include this, one
+// copy each, so plain inline functions do.
+
+// Simple undirected graph, every pair an edge with probability density
+inline auto randomMatrix(size_t vertexCount, double density, unsigned seed)
+    -> std::vector<std::vector<int>> {
+    std::mt19937 generator{seed};
+    std::bernoulli_distribution edge{density};
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = i + 1; j < vertexCount; ++j) {
+            if (edge(generator)) {
+                matrix[i][j] = matrix[j][i] = 1;
+            }
+        }
+    }
+    return matrix;
+}
+
+// Every nonzero entry as a bit
+inline auto toBits(const std::vector<std::vector<int>>& matrix)
+    -> bits::BitMatrix {
+    bits::BitMatrix adjacency{matrix.size()};
+    for (size_t i = 0; i < matrix.size(); ++i) {
+        for (size_t j = 0; j < matrix.size(); ++j) {
+            if (matrix[i][j] != 0) {
+                adjacency.set(i, j);
+            }
+        }
+    }
+    return adjacency;
+}
+
+// Every nonzero entry as a neighbour, each list sorted
+inline auto toLists(const std::vector<std::vector<int>>& matrix)
+    -> std::vector<std::vector<size_t>> {
+    std::vector<std::vector<size_t>> neighbours(matrix.size());
+    for (size_t i = 0; i < matrix.size(); ++i) {
+        for (size_t j = 0; j < matrix.size(); ++j) {
+            if (matrix[i][j] != 0) {
+                neighbours[i].push_back(j);
+            }
+        }
+    }
+    return neighbours;
+}
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "independent_set.hpp"
+#include "test_graphs.hpp"
+#include "vertex_cover.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+using Neighbours = std::vector<std::vector<size_t>>;
+
+auto addEdge(Neighbours& neighbours, size_t i, size_t j) -> void {
+    neighbours[i].push_back(j);
+    neighbours[j].push_back(i);
+}
+
+auto isIndependent(const Neighbours& neighbours,
+                   const std::vector<size_t>& set) -> bool {
+    std::vector<bool> isIn(neighbours.size());
+    for (size_t vertex : set) {
+        isIn[vertex] = true;
+    }
+    return std::ranges::all_of(set, [&](size_t vertex) {
+        return std::ranges::none_of(neighbours[vertex],
+                                    [&](size_t other) { return isIn[other]; });
+    });
+}
+
+// Biggest independent set over every subset
+auto bruteForceSize(const Neighbours& neighbours) -> size_t {
+    size_t vertexCount = neighbours.size();
+    size_t best = 0;
+    for (size_t subset = 0; subset < (size_t{1} << vertexCount); ++subset) {
+        std::vector<size_t> set;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if ((subset >> vertex & 1U) != 0) {
+                set.push_back(vertex);
+            }
+        }
+        if (set.size() > best && isIndependent(neighbours, set)) {
+            best = set.size();
+        }
+    }
+    return best;
+}
+
+auto checked(const Neighbours& neighbours) -> size_t {
+    auto set = clique::maximumIndependentSet(neighbours);
+    REQUIRE(std::ranges::is_sorted(set));
+    REQUIRE(std::ranges::adjacent_find(set) == set.end());
+    REQUIRE(isIndependent(neighbours, set));
+    return set.size();
+}
+
+}  // namespace
+
+TEST_CASE("Maximum independent set") {
+    SECTION("Matches brute force") {
+        for (unsigned seed = 0; seed < 20; ++seed) {
+            for (double density : {0.1, 0.25, 0.4, 0.7}) {
+                auto neighbours = toLists(randomMatrix(12, density, seed));
+                REQUIRE(checked(neighbours) == bruteForceSize(neighbours));
+            }
+        }
+    }
+
+    SECTION("Complements a minimum vertex cover") {
+        for (unsigned seed = 0; seed < 5; ++seed) {
+            for (double density : {0.05, 0.1, 0.2}) {
+                auto matrix = randomMatrix(50, density, seed);
+                REQUIRE(checked(toLists(matrix)) ==
+                        50 - clique::minimumVertexCover(toBits(matrix)).size());
+            }
+        }
+    }
+
+    SECTION("Paths and cycles, all degree 2 folds") {
+        for (size_t vertexCount : {7, 8, 31}) {
+            Neighbours path(vertexCount);
+            Neighbours cycle(vertexCount);
+            for (size_t vertex = 0; vertex + 1 < vertexCount; ++vertex) {
+                addEdge(path, vertex, vertex + 1);
+                addEdge(cycle, vertex, vertex + 1);
+            }
+            addEdge(cycle, vertexCount - 1, 0);
+
+            REQUIRE(checked(path) == (vertexCount + 1) / 2);
+            REQUIRE(checked(cycle) == vertexCount / 2);
+        }
+    }
+
+    SECTION("Twins") {
+        // 0 and 1 both see exactly 2, 3, 4, which have no edges among them,
+        // and 2, 3, 4 hang on to a path so they aren't obviously out
+        Neighbours folded(9);
+        for (size_t twin : {0, 1}) {
+            for (size_t shared : {2, 3, 4}) {
+                addEdge(folded, twin, shared);
+            }
+        }
+        addEdge(folded, 2, 5);
+        addEdge(folded, 3, 6);
+        addEdge(folded, 4, 7);
+        addEdge(folded, 5, 8);
+        REQUIRE(checked(folded) == bruteForceSize(folded));
+
+        // With an edge among the neighbours, both twins are in for sure
+        auto withEdge = folded;
+        addEdge(withEdge, 2, 3);
+        REQUIRE(checked(withEdge) == bruteForceSize(withEdge));
+    }
+
+    SECTION("Stars, cliques and separate components") {
+        Neighbours star(30);
+        for (size_t leaf = 1; leaf < 30; ++leaf) {
+            addEdge(star, 0, leaf);
+        }
+        REQUIRE(checked(star) == 29);
+
+        // Ten disjoint K4s
+        Neighbours cliques(40);
+        for (size_t i = 0; i < 40; ++i) {
+            for (size_t j = i + 1; j < i / 4 * 4 + 4; ++j) {
+                addEdge(cliques, i, j);
+            }
+        }
+        REQUIRE(checked(cliques) == 10);
+
+        REQUIRE(checked({}) == 0);
+        REQUIRE(checked(Neighbours(5)) == 5);
+    }
+
+    SECTION("Big random trees") {
+        // Leaves first, a tree takes a vertex iff none of its children are
+        // taken, which is optimal
+        constexpr size_t vertexCount = 3000;
+        std::mt19937 generator{42};
+        Neighbours tree(vertexCount);
+        std::vector<size_t> parents(vertexCount);
+        for (size_t vertex = 1; vertex < vertexCount; ++vertex) {
+            parents[vertex] =
+                std::uniform_int_distribution<size_t>{0, vertex - 1}(generator);
+            addEdge(tree, vertex, parents[vertex]);
+        }
+
+        std::vector<bool> isTaken(vertexCount, true);
+        size_t expected = 0;
+        for (size_t vertex = vertexCount; vertex-- > 0;) {
+            if (isTaken[vertex]) {
+                ++expected;
+                if (vertex > 0) {
+                    isTaken[parents[vertex]] = false;
+                }
+            }
+        }
+        REQUIRE(checked(tree) == expected);
+    }
+}
+
+TEST_CASE("Independent sets of graphs") {
+    SECTION("Edges count either way, loops don't") {
+        // 0 -> 1 only, 2 <-> 3, 4 has a loop
+        Graph graph{std::istringstream{"5\n"
+                                       "0 1 0 0 0\n"
+                                       "0 0 0 0 0\n"
+                                       "0 0 0 1 0\n"
+                                       "0 0 1 0 0\n"
+                                       "0 0 0 0 1"}};
+        auto set = graph.maximumIndependentSet();
+        REQUIRE(set.size() == 3);
+        REQUIRE(std::ranges::find(set, 4) != set.end());
+    }
+
+    SECTION("Max clique of a dense graph, through the complement") {
+        for (unsigned seed = 0; seed < 5; ++seed) {
+            auto complement = toLists(randomMatrix(60, 0.05, seed));
+            std::vector<std::vector<int>> matrix(60, std::vector<int>(60, 1));
+            for (size_t i = 0; i < 60; ++i) {
+                matrix[i][i] = 0;
+                for (size_t j : complement[i]) {
+                    matrix[i][j] = 0;
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            auto clique = graph.maxClique();
+            REQUIRE(clique.size() == checked(complement));
+            for (size_t i : clique) {
+                for (size_t j : clique) {
+                    REQUIRE((i == j || graph[i][j] != 0));
+                }
+            }
+        }
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
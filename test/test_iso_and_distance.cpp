@@ -1,4 +1,7 @@
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <sstream>
 
 #include "catch_amalgamated.hpp"
@@ -213,5 +216,50 @@ TEST_CASE("Graph construction, isomorphism and distance sanity checks") {
     // like later on
 }
 
+TEST_CASE("Isomorphism of graphs way too big to brute force") {
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<int> edgeWeight{0, 2};
+
+    // 64, 128, 256 and dynamic buckets
+    for (size_t vertexCount : {40, 100, 200, 300}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (auto& row : matrix) {
+                for (auto& weight : row) {
+                    weight = edgeWeight(generator);
+                }
+            }
+
+            std::vector<size_t> relabel(vertexCount);
+            std::iota(relabel.begin(), relabel.end(), 0);
+            std::shuffle(relabel.begin(), relabel.end(), generator);
+
+            std::vector<std::vector<int>> relabelledMatrix(
+                vertexCount, std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = 0; j < vertexCount; ++j) {
+                    relabelledMatrix[relabel[i]][relabel[j]] = matrix[i][j];
+                }
+            }
+
+            Graph original{std::vector<std::vector<int>>{matrix}};
+            Graph relabelled{std::vector<std::vector<int>>{relabelledMatrix}};
+            REQUIRE(original == relabelled);
+
+            // Flipping one lopsided pair of edges keeps the size, but not the
+            // shape
+            size_t from = 1;
+            while (relabelledMatrix[0][from] == relabelledMatrix[from][0]) {
+                ++from;
+            }
+            std::swap(relabelledMatrix[0][from], relabelledMatrix[from][0]);
+            Graph tampered{std::vector<std::vector<int>>{relabelledMatrix}};
+            REQUIRE(original.getSize() == tampered.getSize());
+            REQUIRE(original != tampered);
+        }
+    }
+}
+
 // NOLINTEND(readability-function-cognitive-complexity)
 // NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "local_search.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+// Sparse random graph with a clique planted on random vertices
+auto plantedClique(size_t vertexCount, size_t plantedSize, double density,
+                   unsigned seed) -> bits::BitMatrix {
+    std::mt19937 generator{seed};
+    std::bernoulli_distribution edge{density};
+    bits::BitMatrix adjacency{vertexCount};
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = i + 1; j < vertexCount; ++j) {
+            if (edge(generator)) {
+                bits::set(adjacency[i], j);
+                bits::set(adjacency[j], i);
+            }
+        }
+    }
+
+    std::vector<size_t> vertices(vertexCount);
+    std::iota(vertices.begin(), vertices.end(), 0);
+    std::shuffle(vertices.begin(), vertices.end(), generator);
+    vertices.resize(plantedSize);
+    for (size_t i : vertices) {
+        for (size_t j : vertices) {
+            if (i != j) {
+                bits::set(adjacency[i], j);
+            }
+        }
+    }
+
+    return adjacency;
+}
+
+}  // namespace
+
+TEST_CASE("Local search") {
+    constexpr size_t vertexCount = 1000;
+    constexpr size_t plantedSize = 15;
+    auto adjacency = plantedClique(vertexCount, plantedSize, 0.05, 7);
+
+    SECTION("Only visits maximal cliques") {
+        size_t visits = 0;
+        clique::localSearch(
+            adjacency, {.maxSteps = 2000, .seed = 1},
+            [&](std::span<const size_t> found) {
+                ++visits;
+                for (size_t i : found) {
+                    for (size_t j : found) {
+                        REQUIRE((i == j || bits::test(adjacency[i], j)));
+                    }
+                }
+
+                // Nothing outside is adjacent to all of it
+                for (size_t other = 0; other < vertexCount; ++other) {
+                    if (std::ranges::find(found, other) != found.end()) {
+                        continue;
+                    }
+                    REQUIRE_FALSE(std::ranges::all_of(found, [&](size_t i) {
+                        return bits::test(adjacency[i], other);
+                    }));
+                }
+            });
+        REQUIRE(visits > 0);
+    }
+
+    SECTION("Same seed, same run") {
+        auto record = [&](std::uint64_t seed) {
+            std::vector<std::vector<size_t>> seen;
+            clique::localSearch(adjacency, {.maxSteps = 3000, .seed = seed},
+                                [&](std::span<const size_t> found) {
+                                    seen.emplace_back(found.begin(),
+                                                      found.end());
+                                });
+            return seen;
+        };
+
+        REQUIRE(record(3) == record(3));
+        REQUIRE(record(3) != record(4));
+    }
+
+    SECTION("Finds the planted clique, whatever the seed") {
+        for (std::uint64_t seed : {1, 2, 3}) {
+            size_t best = 0;
+            clique::localSearch(adjacency,
+                                {.maxSteps = 10 * vertexCount, .seed = seed},
+                                [&](std::span<const size_t> found) {
+                                    best = std::max(best, found.size());
+                                });
+            REQUIRE(best == plantedSize);
+        }
+    }
+
+    SECTION("Nothing to search") {
+        size_t visits = 0;
+        clique::localSearch(bits::BitMatrix{0}, {.maxSteps = 100, .seed = 1},
+                            [&](std::span<const size_t>) { ++visits; });
+        REQUIRE(visits == 0);
+    }
+}
+
+TEST_CASE("Approximate searches go through the local search") {
+    // Relabelling the vertices used to matter a lot for the approximation,
+    // it shouldn't anymore
+    constexpr size_t vertexCount = 300;
+    constexpr size_t plantedSize = 12;
+    auto adjacency = plantedClique(vertexCount, plantedSize, 0.1, 11);
+
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = 0; j < vertexCount; ++j) {
+            matrix[i][j] = static_cast<int>(bits::test(adjacency[i], j));
+        }
+    }
+    Graph graph{std::move(matrix)};
+
+    auto approximate = graph.maxClique(AlgorithmAccuracy::APPROXIMATE);
+    REQUIRE(approximate.size() == plantedSize);
+    REQUIRE(std::ranges::is_sorted(approximate));
+    REQUIRE(approximate == graph.maxClique(AlgorithmAccuracy::APPROXIMATE));
+
+    auto all = graph.allMaxCliques(AlgorithmAccuracy::APPROXIMATE);
+    REQUIRE(std::ranges::find(all, approximate) != all.end());
+    REQUIRE(std::ranges::adjacent_find(all) == all.end());
+
+    REQUIRE(graph.modifiedMaxClique(AlgorithmAccuracy::APPROXIMATE).size() ==
+            plantedSize);
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <iostream>
+#include <numeric>
+#include <random>
 #include <sstream>
 
 #include "catch_amalgamated.hpp"
@@ -163,5 +168,473 @@ TEST_CASE("Disconnected Graph with 6 Vertices") {
     }
 }
 
+TEST_CASE("All maximum cliques, not just the first") {
+    Graph largeDisconnectedGraph =
+        Graph{std::istringstream{"8\n"
+                                 "0 1 0 0 0 0 0 0\n"
+                                 "1 0 0 0 0 0 0 0\n"
+                                 "0 0 0 1 0 0 0 0\n"
+                                 "0 0 1 0 0 0 0 0\n"
+                                 "0 0 0 0 0 1 0 0\n"
+                                 "0 0 0 0 1 0 0 0\n"
+                                 "0 0 0 0 0 0 0 1\n"
+                                 "0 0 0 0 0 0 1 0"}};
+    Graph twoTriangles =
+        Graph{std::istringstream{"5\n"
+                                 "0 1 1 0 0\n"
+                                 "1 0 1 1 0\n"
+                                 "1 1 0 1 0\n"
+                                 "0 1 1 0 1\n"
+                                 "0 0 0 1 0"}};
+
+    SECTION("Every component shows up") {
+        auto cliques = largeDisconnectedGraph.allMaxCliques();
+        REQUIRE(cliques == std::vector<std::vector<size_t>>{
+                               {0, 1}, {2, 3}, {4, 5}, {6, 7}});
+        REQUIRE(largeDisconnectedGraph.maxClique() == cliques[0]);
+    }
+
+    SECTION("Overlapping maximum cliques") {
+        auto cliques = twoTriangles.allMaxCliques();
+        REQUIRE(cliques ==
+                std::vector<std::vector<size_t>>{{0, 1, 2}, {1, 2, 3}});
+        REQUIRE(twoTriangles.maxClique() == cliques[0]);
+    }
+
+    SECTION("The null graph just has the empty clique") {
+        REQUIRE(Graph{std::istringstream{"0"}}.allMaxCliques() ==
+                std::vector<std::vector<size_t>>{{}});
+    }
+}
+
+TEST_CASE("Planted cliques in every size bucket") {
+    constexpr size_t plantedSize = 12;
+    std::mt19937 generator{11};
+    std::bernoulli_distribution sparseEdge{0.1};
+
+    // 64, 128, 256 and dynamic buckets
+    for (size_t vertexCount : {50, 100, 200, 300}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = i + 1; j < vertexCount; ++j) {
+                    matrix[i][j] = matrix[j][i] =
+                        static_cast<int>(sparseEdge(generator));
+                }
+            }
+
+            std::vector<size_t> vertices(vertexCount);
+            std::iota(vertices.begin(), vertices.end(), 0);
+            std::shuffle(vertices.begin(), vertices.end(), generator);
+            vertices.resize(plantedSize);
+            for (size_t i : vertices) {
+                for (size_t j : vertices) {
+                    matrix[i][j] = static_cast<int>(i != j);
+                }
+            }
+
+            Graph graph{std::move(matrix)};
+            auto clique = graph.maxClique();
+            REQUIRE(clique.size() == plantedSize);
+            for (size_t i : clique) {
+                for (size_t j : clique) {
+                    REQUIRE((i == j || graph[i][j] > 0));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Parallel search agrees with the sequential one") {
+    constexpr size_t threadCount = 4;
+    std::mt19937 generator{29};
+    std::bernoulli_distribution denseEdge{0.5};
+
+    // 64, 128, 256 and dynamic buckets again
+    for (size_t vertexCount : {40, 100, 200, 300}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = i + 1; j < vertexCount; ++j) {
+                    matrix[i][j] = matrix[j][i] =
+                        static_cast<int>(denseEdge(generator));
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            auto sequential = graph.allMaxCliques();
+            REQUIRE(graph.allMaxCliques(AlgorithmAccuracy::EXACT,
+                                        threadCount) == sequential);
+
+            // Any of the maximum cliques is fine here
+            auto clique =
+                graph.maxClique(AlgorithmAccuracy::EXACT, threadCount);
+            REQUIRE(std::ranges::find(sequential, clique) != sequential.end());
+        }
+    }
+
+    SECTION("More threads than work") {
+        Graph triangle = Graph{std::istringstream{"3\n"
+                                                  "0 1 1\n"
+                                                  "1 0 1\n"
+                                                  "1 1 0"}};
+        REQUIRE(triangle.maxClique(AlgorithmAccuracy::EXACT, threadCount) ==
+                std::vector<size_t>{0, 1, 2});
+        REQUIRE(Graph{std::istringstream{"0"}}.allMaxCliques(
+                    AlgorithmAccuracy::EXACT, threadCount) ==
+                std::vector<std::vector<size_t>>{{}});
+    }
+}
+
+TEST_CASE("Every engine finds a maximum clique") {
+    constexpr std::array engines{
+        CliqueEngine::AUTO, CliqueEngine::BRANCH_AND_BOUND,
+        CliqueEngine::RUSSIAN_DOLL, CliqueEngine::COMPLEMENT,
+        CliqueEngine::PORTFOLIO};
+    std::mt19937 generator{31};
+
+    // Sparse to dense, and some directed edges that don't count
+    for (double density : {0.05, 0.3, 0.6, 0.9}) {
+        DYNAMIC_SECTION("density " << density) {
+            constexpr size_t vertexCount = 60;
+            std::bernoulli_distribution edge{density};
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = 0; j < vertexCount; ++j) {
+                    matrix[i][j] = static_cast<int>(i != j && edge(generator));
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            auto all = graph.allMaxCliques();
+            for (auto engine : engines) {
+                auto clique =
+                    graph.maxClique(AlgorithmAccuracy::EXACT, 1, engine);
+                REQUIRE(std::ranges::find(all, clique) != all.end());
+            }
+
+            // The portfolio's first branch and bound on threads of its own
+            auto threaded = graph.maxClique(AlgorithmAccuracy::EXACT, 4,
+                                            CliqueEngine::PORTFOLIO);
+            REQUIRE(std::ranges::find(all, threaded) != all.end());
+        }
+    }
+
+    SECTION("Small cases") {
+        Graph empty{std::istringstream{"0"}};
+        Graph lonely{std::istringstream{"2\n"
+                                        "1 1\n"
+                                        "0 0"}};
+        for (auto engine : engines) {
+            REQUIRE(empty.maxClique(AlgorithmAccuracy::EXACT, 1, engine)
+                        .empty());
+            REQUIRE(
+                lonely.maxClique(AlgorithmAccuracy::EXACT, 1, engine).size() ==
+                1);
+        }
+    }
+}
+
+TEST_CASE("Anytime search") {
+    constexpr size_t vertexCount = 150;
+    std::mt19937 generator{31};
+    std::bernoulli_distribution denseEdge{0.6};
+
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = i + 1; j < vertexCount; ++j) {
+            matrix[i][j] = matrix[j][i] =
+                static_cast<int>(denseEdge(generator));
+        }
+    }
+    Graph graph{std::move(matrix)};
+
+    auto isClique = [&](const std::vector<size_t>& clique) {
+        return std::ranges::all_of(clique, [&](size_t i) {
+            return std::ranges::all_of(
+                clique, [&](size_t j) { return i == j || graph[i][j] > 0; });
+        });
+    };
+
+    SECTION("Without limits it's just maxClique") {
+        auto found = graph.anytimeMaxClique({});
+        REQUIRE(found.isOptimal);
+        REQUIRE(found.clique == graph.maxClique());
+    }
+
+    SECTION("Node limit stops early and reports every improvement") {
+        std::vector<size_t> sizes;
+        auto found = graph.anytimeMaxClique(
+            {.timeLimit = {}, .nodeLimit = 50},
+            [&](const std::vector<size_t>& clique) {
+                REQUIRE(isClique(clique));
+                sizes.push_back(clique.size());
+            });
+
+        REQUIRE_FALSE(found.isOptimal);
+        REQUIRE(found.nodeCount == 50);
+        REQUIRE(isClique(found.clique));
+        REQUIRE(std::ranges::is_sorted(sizes));
+        REQUIRE(std::ranges::adjacent_find(sizes) == sizes.end());
+        REQUIRE(sizes.back() == found.clique.size());
+        REQUIRE(found.clique.size() <= graph.maxClique().size());
+    }
+
+    SECTION("A node limit of exactly the search's size is enough") {
+        auto full = graph.anytimeMaxClique({});
+        REQUIRE(full.nodeCount > 1);
+
+        auto exact = graph.anytimeMaxClique(
+            {.timeLimit = {}, .nodeLimit = full.nodeCount});
+        REQUIRE(exact.isOptimal);
+        REQUIRE(exact.nodeCount == full.nodeCount);
+        REQUIRE(exact.clique == full.clique);
+
+        auto cut = graph.anytimeMaxClique(
+            {.timeLimit = {}, .nodeLimit = full.nodeCount - 1});
+        REQUIRE_FALSE(cut.isOptimal);
+        REQUIRE(cut.nodeCount == full.nodeCount - 1);
+    }
+
+    SECTION("Time limit still hands back a clique") {
+        auto found = graph.anytimeMaxClique(
+            {.timeLimit = std::chrono::milliseconds{0}, .nodeLimit = {}});
+        REQUIRE_FALSE(found.isOptimal);
+        REQUIRE_FALSE(found.clique.empty());
+        REQUIRE(isClique(found.clique));
+    }
+}
+
+TEST_CASE("Warm started search") {
+    constexpr std::array engines{
+        CliqueEngine::AUTO, CliqueEngine::BRANCH_AND_BOUND,
+        CliqueEngine::RUSSIAN_DOLL, CliqueEngine::COMPLEMENT,
+        CliqueEngine::PORTFOLIO};
+    constexpr size_t vertexCount = 60;
+    std::mt19937 generator{37};
+    std::bernoulli_distribution edge{0.6};
+
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = i + 1; j < vertexCount; ++j) {
+            matrix[i][j] = matrix[j][i] = static_cast<int>(edge(generator));
+        }
+    }
+    Graph graph{std::move(matrix)};
+    auto all = graph.allMaxCliques();
+    auto best = graph.maxClique();
+
+    std::vector<size_t> shuffled(vertexCount);
+    std::iota(shuffled.begin(), shuffled.end(), 0);
+    std::ranges::shuffle(shuffled, generator);
+
+    SECTION("A maximum clique as the hint is the answer") {
+        CliqueHint hint{{best.rbegin(), best.rend()}, {}};
+        for (auto engine : engines) {
+            REQUIRE(graph.maxClique(hint, AlgorithmAccuracy::EXACT, 1,
+                                    engine) == best);
+        }
+        REQUIRE(graph.maxClique(hint, AlgorithmAccuracy::APPROXIMATE) ==
+                best);
+    }
+
+    SECTION("Smaller hints and other orders still find a maximum") {
+        for (const auto& hint :
+             {CliqueHint{{best[1], best[0]}, {}}, CliqueHint{{}, shuffled},
+              CliqueHint{{best[0]}, shuffled}}) {
+            for (auto engine : engines) {
+                auto clique =
+                    graph.maxClique(hint, AlgorithmAccuracy::EXACT, 1, engine);
+                REQUIRE(std::ranges::find(all, clique) != all.end());
+            }
+            auto parallel = graph.maxClique(hint, AlgorithmAccuracy::EXACT, 3);
+            REQUIRE(std::ranges::find(all, parallel) != all.end());
+        }
+    }
+
+    SECTION("Anytime search starts from the hint without reporting it") {
+        std::vector<size_t> sizes;
+        auto found = graph.anytimeMaxClique(
+            {.timeLimit = {}, .nodeLimit = 1},
+            [&](const std::vector<size_t>& clique) {
+                sizes.push_back(clique.size());
+            },
+            {best, shuffled});
+        REQUIRE(found.clique == best);
+        REQUIRE(sizes.empty());
+
+        auto unlimited = graph.anytimeMaxClique({}, {}, {{best[0]}, shuffled});
+        REQUIRE(unlimited.isOptimal);
+        REQUIRE(std::ranges::find(all, unlimited.clique) != all.end());
+    }
+
+    SECTION("Bad hints get turned down") {
+        std::vector<size_t> missingOne(shuffled.begin() + 1, shuffled.end());
+        std::vector<size_t> repeatedOne = shuffled;
+        repeatedOne.back() = repeatedOne.front();
+        size_t stranger = 0;
+        while (graph[best[0]][stranger] > 0 || stranger == best[0]) {
+            ++stranger;
+        }
+
+        for (const auto& hint :
+             {CliqueHint{{vertexCount}, {}}, CliqueHint{{best[0], best[0]}, {}},
+              CliqueHint{{best[0], stranger}, {}}, CliqueHint{{}, missingOne},
+              CliqueHint{{}, repeatedOne}}) {
+            REQUIRE_THROWS_AS(graph.maxClique(hint), std::invalid_argument);
+            REQUIRE_THROWS_AS(graph.anytimeMaxClique({}, {}, hint),
+                              std::invalid_argument);
+        }
+    }
+}
+
+TEST_CASE("Decision version") {
+    std::mt19937 generator{41};
+    std::bernoulli_distribution edge{0.6};
+
+    for (size_t vertexCount : {30, 90, 150}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = i + 1; j < vertexCount; ++j) {
+                    matrix[i][j] = matrix[j][i] =
+                        static_cast<int>(edge(generator));
+                }
+            }
+            Graph graph{std::move(matrix)};
+            auto maximum = graph.maxClique();
+
+            for (size_t size = 0; size <= maximum.size() + 2; ++size) {
+                bool exists = size <= maximum.size();
+                REQUIRE(graph.hasCliqueOfSize(size) == exists);
+                REQUIRE(graph.hasCliqueOfSize(size, 4) == exists);
+
+                auto witness = graph.findCliqueOfSize(size);
+                if (!exists) {
+                    REQUIRE_FALSE(witness);
+                    continue;
+                }
+                REQUIRE(witness->size() == size);
+                REQUIRE(std::ranges::is_sorted(*witness));
+                for (size_t i : *witness) {
+                    for (size_t j : *witness) {
+                        REQUIRE((i == j || (graph[i][j] != 0 &&
+                                            graph[j][i] != 0)));
+                    }
+                }
+            }
+
+            // The first witness of the maximum size is the first maximum
+            REQUIRE(graph.findCliqueOfSize(maximum.size()) == maximum);
+        }
+    }
+
+    SECTION("Nothing bigger than the graph") {
+        Graph triangle = Graph{std::istringstream{"3\n"
+                                                  "0 1 1\n"
+                                                  "1 0 1\n"
+                                                  "1 1 0"}};
+        REQUIRE(triangle.hasCliqueOfSize(3));
+        REQUIRE_FALSE(triangle.hasCliqueOfSize(4));
+        REQUIRE(Graph{std::istringstream{"0"}}.findCliqueOfSize(0) ==
+                std::vector<size_t>{});
+    }
+}
+
+TEST_CASE("Top k cliques") {
+    std::mt19937 generator{43};
+    std::bernoulli_distribution edge{0.5};
+
+    for (size_t vertexCount : {25, 80, 140}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = i + 1; j < vertexCount; ++j) {
+                    matrix[i][j] = matrix[j][i] =
+                        static_cast<int>(edge(generator));
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            // Every maximal clique, ranked the same way
+            std::vector<std::vector<size_t>> ranked;
+            for (const auto& clique : graph.maximalCliques()) {
+                ranked.push_back(clique);
+            }
+            std::ranges::stable_sort(ranked, [](const auto& lhs,
+                                                const auto& rhs) {
+                return lhs.size() > rhs.size();
+            });
+
+            for (size_t count : {1, 3, 10, 50}) {
+                auto top = graph.topKCliques(count);
+                size_t expected = std::min(count, ranked.size());
+                REQUIRE(top == std::vector(ranked.begin(),
+                                           ranked.begin() + expected));
+
+                // Ties at the cut can go either way with threads
+                auto parallel = graph.topKCliques(count, 4);
+                REQUIRE(parallel.size() == expected);
+                for (size_t i = 0; i < expected; ++i) {
+                    REQUIRE(parallel[i].size() == top[i].size());
+                    REQUIRE(std::ranges::find(ranked, parallel[i]) !=
+                            ranked.end());
+                }
+                REQUIRE(std::ranges::adjacent_find(parallel) ==
+                        parallel.end());
+            }
+
+            REQUIRE(graph.topKCliques(1).front() == graph.maxClique());
+        }
+    }
+
+    SECTION("Fewer maximal cliques than asked for") {
+        // Without cutting non maximal branches, every subset gets visited
+        for (size_t vertexCount : {40, 100}) {
+            std::vector<std::vector<int>> matrix(
+                vertexCount, std::vector<int>(vertexCount, 1));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                matrix[i][i] = 0;
+            }
+            std::vector<size_t> all(vertexCount);
+            std::iota(all.begin(), all.end(), 0);
+            Graph complete{std::vector<std::vector<int>>(matrix)};
+            REQUIRE(complete.topKCliques(2) ==
+                    std::vector<std::vector<size_t>>{all});
+            REQUIRE(complete.topKCliques(3, 4) ==
+                    std::vector<std::vector<size_t>>{all});
+
+            matrix[0][1] = matrix[1][0] = 0;
+            auto withoutOne = all;
+            withoutOne.erase(withoutOne.begin() + 1);
+            auto withoutZero = all;
+            withoutZero.erase(withoutZero.begin());
+            Graph almost{std::move(matrix)};
+            REQUIRE(almost.topKCliques(3) ==
+                    std::vector<std::vector<size_t>>{withoutOne, withoutZero});
+        }
+    }
+
+    SECTION("Small cases") {
+        Graph disconnected = Graph{std::istringstream{"4\n"
+                                                      "0 1 0 0\n"
+                                                      "1 0 0 0\n"
+                                                      "0 0 0 0\n"
+                                                      "0 0 0 0"}};
+        REQUIRE(disconnected.topKCliques(5) ==
+                std::vector<std::vector<size_t>>{{0, 1}, {2}, {3}});
+        REQUIRE(disconnected.topKCliques(0).empty());
+        REQUIRE(Graph{std::istringstream{"0"}}.topKCliques(2, 4) ==
+                std::vector<std::vector<size_t>>{{}});
+    }
+}
+
 // NOLINTEND(readability-function-cognitive-complexity)
 // NOLINTEND(cppcoreguidelines-avoid-do-while)
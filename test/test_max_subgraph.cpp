@@ -130,6 +130,29 @@ TEST_CASE("Maximum induced subgraph tests") {
                                          "0 1\n"
                                          "1 1"}});
     }
+
+    SECTION("Parallel search gives the same subgraph") {
+        constexpr size_t threadCount = 3;
+        REQUIRE(modProductWikiExample.maxSubgraph(
+                    multiEdgeTriangleGraph, AlgorithmAccuracy::EXACT,
+                    threadCount) ==
+                modProductWikiExample.maxSubgraph(multiEdgeTriangleGraph));
+        REQUIRE(multiEdgeTriangleGraph.maxSubgraph(multiEdgeTwoGraph,
+                                                   AlgorithmAccuracy::EXACT,
+                                                   threadCount) ==
+                multiEdgeTriangleGraph.maxSubgraph(multiEdgeTwoGraph));
+    }
+
+    SECTION("Portfolio gives the same subgraph") {
+        REQUIRE(modProductWikiExample.maxSubgraph(
+                    multiEdgeTriangleGraph, AlgorithmAccuracy::EXACT, 1,
+                    CliqueEngine::PORTFOLIO) ==
+                modProductWikiExample.maxSubgraph(multiEdgeTriangleGraph));
+        REQUIRE(multiEdgeTriangleGraph.maxSubgraph(
+                    multiEdgeTwoGraph, AlgorithmAccuracy::EXACT, 1,
+                    CliqueEngine::PORTFOLIO) ==
+                multiEdgeTriangleGraph.maxSubgraph(multiEdgeTwoGraph));
+    }
 }
 
 // NOLINTEND(readability-function-cognitive-complexity)
@@ -1,4 +1,6 @@
+#include <array>
 #include <iostream>
+#include <random>
 #include <sstream>
 
 #include "catch_amalgamated.hpp"
@@ -162,5 +164,89 @@ TEST_CASE("Disconnected Graph with 6 Vertices") {
     }
 }
 
+TEST_CASE("Tie-break matches brute force") {
+    std::mt19937 generator{11};
+    std::uniform_int_distribution<int> weight{0, 3};
+    std::bernoulli_distribution present{0.5};
+    constexpr size_t vertexCount = 11;
+
+    for (int round = 0; round < 30; ++round) {
+        std::vector<std::vector<int>> matrix(vertexCount,
+                                             std::vector<int>(vertexCount));
+        for (size_t i = 0; i < vertexCount; ++i) {
+            for (size_t j = 0; j < vertexCount; ++j) {
+                matrix[i][j] = i == j || !present(generator) ? 0
+                                                             : weight(generator);
+            }
+        }
+
+        // Best by (size, connections, edges), then lexicographically first
+        std::vector<size_t> expected;
+        std::array<size_t, 3> expectedScore{};
+        for (size_t subset = 0; subset < (size_t{1} << vertexCount);
+             ++subset) {
+            std::vector<size_t> members;
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                if ((subset >> vertex & 1U) != 0) {
+                    members.push_back(vertex);
+                }
+            }
+
+            std::array<size_t, 3> score{members.size(), 0, 0};
+            bool isClique = true;
+            for (size_t i = 0; i < members.size() && isClique; ++i) {
+                for (size_t j = i + 1; j < members.size(); ++j) {
+                    int there = matrix[members[i]][members[j]];
+                    int back = matrix[members[j]][members[i]];
+                    if (there == 0 && back == 0) {
+                        isClique = false;
+                        break;
+                    }
+                    score[1] += static_cast<size_t>(there > 0) +
+                                static_cast<size_t>(back > 0);
+                    score[2] += static_cast<size_t>(there + back);
+                }
+            }
+            if (isClique &&
+                (score > expectedScore ||
+                 (score == expectedScore && members < expected))) {
+                expected = members;
+                expectedScore = score;
+            }
+        }
+
+        Graph graph{std::move(matrix)};
+        REQUIRE(graph.modifiedMaxClique() == expected);
+        REQUIRE(graph.modifiedMaxClique(AlgorithmAccuracy::EXACT, 3) ==
+                expected);
+    }
+}
+
+TEST_CASE("Portfolio picks the same clique") {
+    // Lots of ties, with multi-edges to break them
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<int> weight{0, 3};
+    for (size_t vertexCount : {12, 30, 50}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = 0; j < vertexCount; ++j) {
+                    matrix[i][j] = i == j ? 0 : weight(generator);
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            auto expected = graph.modifiedMaxClique();
+            for (size_t threadCount : {1, 4}) {
+                REQUIRE(graph.modifiedMaxClique(AlgorithmAccuracy::EXACT,
+                                                threadCount,
+                                                CliqueEngine::PORTFOLIO) ==
+                        expected);
+            }
+        }
+    }
+}
+
 // NOLINTEND(readability-function-cognitive-complexity)
 // NOLINTEND(cppcoreguidelines-avoid-do-while)
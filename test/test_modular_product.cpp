@@ -1,5 +1,7 @@
 #include <iostream>
+#include <random>
 #include <sstream>
+#include <stdexcept>
 
 #include "catch_amalgamated.hpp"
 #include "graph.hpp"
@@ -101,6 +103,66 @@ TEST_CASE("Modular product tests") {
                                          "0 1 0 0 0 0\n"
                                          "1 0 0 0 0 0"}});
     }
+
+    SECTION("Negative weights are rejected") {
+        Graph negative{std::istringstream{"2\n"
+                                          "0 -1\n"
+                                          "1 0"}};
+        REQUIRE_THROWS_AS(negative.modularProduct(bidirectTwoGraph),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(bidirectTwoGraph.modularProduct(negative),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("Modular product matches the definition for every size bucket") {
+    std::mt19937 generator{3};
+    std::uniform_int_distribution<int> edgeWeight{-2, 2};
+    auto randomMatrix = [&](size_t vertexCount) {
+        std::vector<std::vector<int>> matrix(vertexCount,
+                                             std::vector<int>(vertexCount));
+        for (auto& row : matrix) {
+            for (auto& weight : row) {
+                // About half the entries end up as non-edges
+                weight = std::max(edgeWeight(generator), 0);
+            }
+        }
+        return matrix;
+    };
+
+    // rhs sizes land in the 64, 128, 256 and dynamic buckets
+    for (size_t rhsVertexCount : {5, 70, 200, 300}) {
+        DYNAMIC_SECTION("rhs with " << rhsVertexCount << " vertices") {
+            auto lhsMatrix = randomMatrix(3);
+            auto rhsMatrix = randomMatrix(rhsVertexCount);
+            Graph lhs{std::vector<std::vector<int>>{lhsMatrix}};
+            Graph rhs{std::vector<std::vector<int>>{rhsMatrix}};
+            Graph product = lhs.modularProduct(rhs);
+
+            REQUIRE(product.getVertexCount() == 3 * rhsVertexCount);
+            bool allMatch = true;
+            for (size_t row = 0; row < product.getVertexCount(); ++row) {
+                auto productRow = product[row];
+                size_t lhsRow = row / rhsVertexCount;
+                size_t rhsRow = row % rhsVertexCount;
+                for (size_t col = 0; col < product.getVertexCount(); ++col) {
+                    size_t lhsCol = col / rhsVertexCount;
+                    size_t rhsCol = col % rhsVertexCount;
+                    int lhsWeight = lhsMatrix[lhsRow][lhsCol];
+                    int rhsWeight = rhsMatrix[rhsRow][rhsCol];
+
+                    int expected = 0;
+                    if (lhsRow != lhsCol && rhsRow != rhsCol) {
+                        expected = lhsWeight == 0 && rhsWeight == 0
+                                       ? 1
+                                       : std::min(lhsWeight, rhsWeight);
+                    }
+                    allMatch = allMatch && productRow[col] == expected;
+                }
+            }
+            REQUIRE(allMatch);
+        }
+    }
 }
 
 // NOLINTEND(readability-function-cognitive-complexity)
@@ -0,0 +1,209 @@
+#include <chrono>
+#include <sstream>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "graph_statistics.hpp"
+#include "test_graphs.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+auto cycle(size_t vertexCount) -> bits::BitMatrix {
+    bits::BitMatrix adjacency{vertexCount};
+    for (size_t i = 0; i < vertexCount; ++i) {
+        adjacency.set(i, (i + 1) % vertexCount);
+        adjacency.set((i + 1) % vertexCount, i);
+    }
+    return adjacency;
+}
+
+}  // namespace
+
+TEST_CASE("Graph statistics") {
+    SECTION("A cycle") {
+        auto statistics = clique::measureStatistics(cycle(8), 64);
+        REQUIRE(statistics.vertexCount == 8);
+        REQUIRE(statistics.edgeCount == 8);
+        REQUIRE(statistics.density == Catch::Approx(16.0 / 56));
+        REQUIRE(statistics.complementDensity == Catch::Approx(40.0 / 56));
+        REQUIRE(statistics.maxDegree == 2);
+        REQUIRE(statistics.degeneracy == 2);
+        REQUIRE(statistics.symmetric);
+
+        REQUIRE_FALSE(clique::measureStatistics(cycle(8), 0).symmetric);
+    }
+
+    SECTION("Degeneracy bounds the clique") {
+        for (unsigned seed : {1, 2, 3}) {
+            Graph graph{randomMatrix(50, 0.3, seed)};
+            auto plan = graph.planMaxClique();
+            REQUIRE(graph.maxClique().size() <=
+                    plan.statistics.degeneracy + 1);
+            REQUIRE(plan.statistics.maxDegree >= plan.statistics.degeneracy);
+        }
+    }
+
+    SECTION("Nothing to measure") {
+        auto statistics = clique::measureStatistics(bits::BitMatrix{0}, 64);
+        REQUIRE(statistics.vertexCount == 0);
+        REQUIRE(statistics.density == 0);
+        REQUIRE(statistics.degeneracy == 0);
+        REQUIRE_FALSE(statistics.symmetric);
+    }
+}
+
+TEST_CASE("Search plans") {
+    Graph sparse{randomMatrix(80, 0.03, 5)};
+    Graph dense{randomMatrix(40, 0.5, 7)};
+    Graph nearlyComplete{randomMatrix(40, 0.97, 9)};
+
+    SECTION("Engines follow the density") {
+        auto sparsePlan = sparse.planMaxClique();
+        REQUIRE(sparsePlan.engine == CliqueEngine::RUSSIAN_DOLL);
+        REQUIRE(sparsePlan.order == VertexOrder::DEGENERACY);
+
+        auto densePlan = dense.planMaxClique();
+        REQUIRE(densePlan.engine == CliqueEngine::BRANCH_AND_BOUND);
+        REQUIRE(densePlan.storage == GraphStorage::FIXED_BITSET);
+        REQUIRE(densePlan.order == VertexOrder::NATURAL);
+
+        auto complementPlan = nearlyComplete.planMaxClique();
+        REQUIRE(complementPlan.engine == CliqueEngine::COMPLEMENT);
+        REQUIRE(complementPlan.storage == GraphStorage::SPARSE);
+    }
+
+    SECTION("Threads and requests change the plan") {
+        auto threaded = sparse.planMaxClique(AlgorithmAccuracy::EXACT, 2);
+        REQUIRE(threaded.engine == CliqueEngine::BRANCH_AND_BOUND);
+        REQUIRE(threaded.order == VertexOrder::DEGREE);
+
+        auto asked = dense.planMaxClique(AlgorithmAccuracy::EXACT, 1,
+                                         CliqueEngine::RUSSIAN_DOLL);
+        REQUIRE(asked.engine == CliqueEngine::RUSSIAN_DOLL);
+
+        auto approximate = dense.planMaxClique(AlgorithmAccuracy::APPROXIMATE);
+        REQUIRE_FALSE(approximate.engine.has_value());
+        REQUIRE(approximate.accuracy == AlgorithmAccuracy::APPROXIMATE);
+    }
+
+    SECTION("AUTO accuracy is settled for the engine") {
+        // Nothing to estimate for a sparse complement, the budget is a time
+        // limit instead
+        Graph tight = nearlyComplete;
+        tight.setExactBudget(std::chrono::nanoseconds{0});
+        auto complementPlan = tight.planMaxClique(AlgorithmAccuracy::AUTO);
+        REQUIRE(complementPlan.accuracy == AlgorithmAccuracy::EXACT);
+        REQUIRE(complementPlan.engine == CliqueEngine::COMPLEMENT);
+        REQUIRE(complementPlan.timeLimit == std::chrono::nanoseconds{0});
+        REQUIRE(complementPlan.incumbents.size() == 1);
+        REQUIRE_FALSE(
+            nearlyComplete.planMaxClique(AlgorithmAccuracy::EXACT)
+                .timeLimit.has_value());
+
+        // Over budget, the estimate's local search is the answer
+        Graph overBudget = dense;
+        overBudget.setExactBudget(std::chrono::nanoseconds{0});
+        auto approximate = overBudget.planMaxClique(AlgorithmAccuracy::AUTO);
+        REQUIRE(approximate.accuracy == AlgorithmAccuracy::APPROXIMATE);
+        REQUIRE_FALSE(approximate.engine.has_value());
+        REQUIRE(approximate.incumbents ==
+                std::vector<std::vector<size_t>>{
+                    dense.maxClique(AlgorithmAccuracy::APPROXIMATE)});
+        REQUIRE(overBudget.maxClique(AlgorithmAccuracy::AUTO) ==
+                dense.maxClique(AlgorithmAccuracy::APPROXIMATE));
+        REQUIRE(overBudget.allMaxCliques(AlgorithmAccuracy::AUTO) ==
+                dense.allMaxCliques(AlgorithmAccuracy::APPROXIMATE));
+
+        // Far too big to finish in no time, so it falls back on the local
+        // search, or better
+        auto matrix = randomMatrix(300, 0.92, 1);
+        Graph hard{std::vector<std::vector<int>>(matrix)};
+        hard.setExactBudget(std::chrono::nanoseconds{0});
+        auto hardPlan = hard.planMaxClique(AlgorithmAccuracy::AUTO);
+        REQUIRE(hardPlan.engine == CliqueEngine::COMPLEMENT);
+        auto fallback = hard.maxClique(AlgorithmAccuracy::AUTO);
+        for (size_t i : fallback) {
+            for (size_t j : fallback) {
+                REQUIRE((i == j || matrix[i][j] != 0));
+            }
+        }
+        REQUIRE(fallback.size() >= hardPlan.incumbents.front().size());
+    }
+
+    SECTION("Planned searches still find maximum cliques") {
+        for (const Graph* graph : {&sparse, &dense, &nearlyComplete}) {
+            auto expected = graph->maxClique(AlgorithmAccuracy::EXACT, 1,
+                                             CliqueEngine::BRANCH_AND_BOUND);
+            REQUIRE(graph->maxClique().size() == expected.size());
+            REQUIRE(graph->maxClique(AlgorithmAccuracy::EXACT, 2).size() ==
+                    expected.size());
+        }
+    }
+
+    SECTION("Subgraphs and isomorphisms") {
+        Graph lhs{randomMatrix(5, 0.5, 11)};
+        Graph rhs{randomMatrix(4, 0.5, 13)};
+        REQUIRE(lhs.planMaxSubgraph(rhs).storage == GraphStorage::DENSE);
+        REQUIRE(lhs.planMaxSubgraph(rhs).statistics.vertexCount == 20);
+        auto threaded = lhs.planMaxSubgraph(rhs, AlgorithmAccuracy::EXACT, 2);
+        REQUIRE(threaded.engine == CliqueEngine::BRANCH_AND_BOUND);
+        REQUIRE(threaded.order == VertexOrder::DEGREE);
+
+        REQUIRE(lhs.planIsomorphism(rhs).reason ==
+                "sizes differ, nothing to check");
+        REQUIRE_FALSE(lhs.planIsomorphism(lhs).engine.has_value());
+    }
+
+    SECTION("Explaining") {
+        std::stringstream explained;
+        explained << dense.planMaxClique();
+        REQUIRE(explained.str().starts_with("maxClique: 40 vertices"));
+        REQUIRE(explained.str().find("branch and bound") != std::string::npos);
+    }
+
+    SECTION("Searches hand over the plan they follow") {
+        std::vector<SearchPlan> plans;
+        auto keep = [&](const SearchPlan& plan) { plans.push_back(plan); };
+
+        auto clique = dense.maxClique(CliqueHint{}, AlgorithmAccuracy::EXACT,
+                                      1, CliqueEngine::AUTO, keep);
+        REQUIRE(clique == dense.maxClique());
+        REQUIRE(plans.size() == 1);
+        auto planned = dense.planMaxClique();
+        REQUIRE(plans[0].operation == planned.operation);
+        REQUIRE(plans[0].engine == planned.engine);
+        REQUIRE(plans[0].statistics.symmetric == planned.statistics.symmetric);
+
+        Graph lhs{randomMatrix(5, 0.5, 11)};
+        Graph rhs{randomMatrix(4, 0.5, 13)};
+        std::stringstream subgraph;
+        std::stringstream expected;
+        subgraph << lhs.maxSubgraph(rhs, AlgorithmAccuracy::EXACT, 1,
+                                    CliqueEngine::AUTO, keep);
+        expected << lhs.maxSubgraph(rhs);
+        REQUIRE(subgraph.str() == expected.str());
+        REQUIRE(plans.size() == 2);
+        REQUIRE(plans[1].operation == "maxSubgraph");
+        REQUIRE(plans[1].storage == lhs.planMaxSubgraph(rhs).storage);
+    }
+}
+
+TEST_CASE("Engine names") {
+    REQUIRE(parseCliqueEngine("auto") == CliqueEngine::AUTO);
+    REQUIRE(parseCliqueEngine("branch-and-bound") ==
+            CliqueEngine::BRANCH_AND_BOUND);
+    REQUIRE(parseCliqueEngine("russian-doll") == CliqueEngine::RUSSIAN_DOLL);
+    REQUIRE(parseCliqueEngine("complement") == CliqueEngine::COMPLEMENT);
+    REQUIRE(parseCliqueEngine("portfolio") == CliqueEngine::PORTFOLIO);
+    REQUIRE_FALSE(parseCliqueEngine("branch and bound"));
+    REQUIRE_FALSE(parseCliqueEngine(""));
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
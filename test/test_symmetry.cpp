@@ -0,0 +1,118 @@
+#include <set>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "symmetry.hpp"
+#include "test_graphs.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+constexpr size_t ROUND_LIMIT = 256;
+
+auto cycle(size_t vertexCount) -> std::vector<std::vector<int>> {
+    std::vector<std::vector<int>> matrix(vertexCount,
+                                         std::vector<int>(vertexCount));
+    for (size_t i = 0; i < vertexCount; ++i) {
+        matrix[i][(i + 1) % vertexCount] = 1;
+        matrix[(i + 1) % vertexCount][i] = 1;
+    }
+    return matrix;
+}
+
+// Copies of the same random graph, so every vertex has a twin in each one
+auto disjointCopies(const std::vector<std::vector<int>>& matrix, size_t copies)
+    -> std::vector<std::vector<int>> {
+    size_t size = matrix.size();
+    std::vector<std::vector<int>> result(size * copies,
+                                         std::vector<int>(size * copies));
+    for (size_t copy = 0; copy < copies; ++copy) {
+        for (size_t i = 0; i < size; ++i) {
+            for (size_t j = 0; j < size; ++j) {
+                result[copy * size + i][copy * size + j] = matrix[i][j];
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Vertex orbits") {
+    SECTION("Vertex transitive graphs are one orbit") {
+        for (size_t vertexCount : {3, 6, 11}) {
+            auto adjacency = toBits(cycle(vertexCount));
+            REQUIRE(clique::vertexOrbits(adjacency, ROUND_LIMIT) ==
+                    std::vector<size_t>(vertexCount, 0));
+        }
+    }
+
+    SECTION("A path folds in half") {
+        auto matrix = cycle(5);
+        matrix[0][4] = matrix[4][0] = 0;
+        REQUIRE(clique::vertexOrbits(toBits(matrix), ROUND_LIMIT) ==
+                std::vector<size_t>{0, 1, 2, 1, 0});
+    }
+
+    SECTION("Random graphs are usually rigid") {
+        auto adjacency = toBits(randomMatrix(40, 0.5, 3));
+        auto orbits = clique::vertexOrbits(adjacency, ROUND_LIMIT);
+        for (size_t vertex = 0; vertex < orbits.size(); ++vertex) {
+            REQUIRE(orbits[vertex] == vertex);
+        }
+    }
+
+    SECTION("Twins land in the same orbit") {
+        auto copies = disjointCopies(randomMatrix(12, 0.5, 5), 3);
+        auto orbits = clique::vertexOrbits(toBits(copies), ROUND_LIMIT);
+        for (size_t vertex = 0; vertex < orbits.size(); ++vertex) {
+            REQUIRE(orbits[vertex] == orbits[vertex % 12]);
+        }
+    }
+
+    SECTION("No budget, no orbits") {
+        REQUIRE(clique::vertexOrbits(toBits(cycle(6)), 0) ==
+                std::vector<size_t>{0, 1, 2, 3, 4, 5});
+        REQUIRE(clique::vertexOrbits(bits::BitMatrix{0}, 1).empty());
+    }
+
+    SECTION("Refinement rounds are charged too") {
+        // The first refinement alone is all one round buys, nothing's left
+        // to search for automorphisms with
+        REQUIRE(clique::vertexOrbits(toBits(cycle(6)), 1) ==
+                std::vector<size_t>{0, 1, 2, 3, 4, 5});
+        REQUIRE(clique::vertexOrbits(toBits(cycle(6)), ROUND_LIMIT) ==
+                std::vector<size_t>(6, 0));
+    }
+}
+
+TEST_CASE("Searching symmetric graphs") {
+    for (unsigned seed : {7, 11, 13}) {
+        DYNAMIC_SECTION("seed " << seed) {
+            Graph graph{disjointCopies(randomMatrix(15, 0.6, seed), 4)};
+
+            auto all = graph.allMaxCliques();
+            std::set<std::vector<size_t>> allSet{all.begin(), all.end()};
+
+            auto found = graph.maxClique();
+            REQUIRE(found.size() == all.front().size());
+            REQUIRE(allSet.contains(found));
+
+            auto parallel = graph.maxClique(AlgorithmAccuracy::EXACT, 2,
+                                            CliqueEngine::BRANCH_AND_BOUND);
+            REQUIRE(parallel.size() == found.size());
+            REQUIRE(allSet.contains(parallel));
+
+            REQUIRE(graph.findCliqueOfSize(found.size()).has_value());
+            REQUIRE_FALSE(graph.findCliqueOfSize(found.size() + 1).has_value());
+        }
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
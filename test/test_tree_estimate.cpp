@@ -0,0 +1,99 @@
+#include <chrono>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "test_graphs.hpp"
+#include "tree_estimate.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+auto complete(size_t vertexCount) -> bits::BitMatrix {
+    bits::BitMatrix adjacency{vertexCount};
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = 0; j < vertexCount; ++j) {
+            if (i != j) {
+                adjacency.set(i, j);
+            }
+        }
+    }
+    return adjacency;
+}
+
+}  // namespace
+
+TEST_CASE("Search tree estimates") {
+    SECTION("Trees with one shape are estimated exactly") {
+        // Only the root branches, every vertex is a leaf under it
+        bits::BitMatrix empty{10};
+        auto flat = clique::estimateTreeSize(empty, {16, 1, 1});
+        REQUIRE(flat.nodes == 1);
+        REQUIRE(flat.probedNodes == 16);
+
+        // The coloring bound prunes the root
+        REQUIRE(clique::estimateTreeSize(empty, {16, 1, 2}).nodes == 0);
+        REQUIRE(clique::estimateTreeSize(complete(10), {16, 1, 11}).nodes ==
+                0);
+    }
+
+    SECTION("Nothing to estimate") {
+        auto nothing = clique::estimateTreeSize(bits::BitMatrix{0}, {16, 1, 1});
+        REQUIRE(nothing.nodes == 0);
+        REQUIRE(nothing.time == std::chrono::nanoseconds{0});
+        REQUIRE(clique::estimateTreeSize(complete(3), {0, 1, 1}).nodes == 0);
+    }
+
+    SECTION("Unpruned trees come out about right") {
+        // Every subset of the vertices but the last one gets expanded
+        auto subsets = clique::estimateTreeSize(complete(12), {512, 3, 0});
+        REQUIRE(subsets.nodes > 2048.0 / 2);
+        REQUIRE(subsets.nodes < 2048.0 * 2);
+    }
+
+    SECTION("Same as the real search, give or take") {
+        for (unsigned seed : {5, 6, 7}) {
+            Graph graph{randomMatrix(70, 0.5, seed)};
+            auto estimate = graph.estimateMaxClique();
+            auto actual = graph.anytimeMaxClique({}, {}).nodeCount;
+            REQUIRE(estimate.nodes > static_cast<double>(actual) / 10);
+            REQUIRE(estimate.nodes < static_cast<double>(actual) * 10);
+            REQUIRE(estimate.time > std::chrono::nanoseconds{0});
+        }
+    }
+}
+
+TEST_CASE("Automatic accuracy") {
+    Graph graph{randomMatrix(60, 0.6, 11)};
+    REQUIRE(graph.getExactBudget() > std::chrono::nanoseconds{0});
+
+    SECTION("Exact when it fits") {
+        graph.setExactBudget(std::chrono::hours{1});
+        REQUIRE(graph.maxClique(AlgorithmAccuracy::AUTO) == graph.maxClique());
+        REQUIRE(graph.modifiedMaxClique(AlgorithmAccuracy::AUTO) ==
+                graph.modifiedMaxClique());
+    }
+
+    SECTION("Approximate when it doesn't") {
+        graph.setExactBudget(std::chrono::nanoseconds{0});
+        REQUIRE(graph.maxClique(AlgorithmAccuracy::AUTO) ==
+                graph.maxClique(AlgorithmAccuracy::APPROXIMATE));
+        REQUIRE(graph.modifiedMaxClique(AlgorithmAccuracy::AUTO) ==
+                graph.modifiedMaxClique(AlgorithmAccuracy::APPROXIMATE));
+    }
+
+    SECTION("Subgraphs keep the budget") {
+        Graph lhs{randomMatrix(6, 0.5, 13)};
+        Graph rhs{randomMatrix(5, 0.5, 17)};
+        lhs.setExactBudget(std::chrono::nanoseconds{0});
+        REQUIRE(lhs.maxSubgraph(rhs, AlgorithmAccuracy::AUTO) ==
+                lhs.maxSubgraph(rhs, AlgorithmAccuracy::APPROXIMATE));
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "test_graphs.hpp"
+#include "triangles.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+TEST_CASE("Triangle counting") {
+    SECTION("Same as the naive way") {
+        for (unsigned seed : {1, 2, 3}) {
+            for (double density : {0.1, 0.5, 0.9}) {
+                // Over a block of rows, so more than one task
+                auto matrix = randomMatrix(150, density, seed);
+                auto counts = clique::countTriangles(toBits(matrix));
+
+                std::uint64_t total = 0;
+                for (size_t i = 0; i < matrix.size(); ++i) {
+                    std::uint64_t triangles = 0;
+                    std::uint64_t degree = 0;
+                    for (size_t j = 0; j < matrix.size(); ++j) {
+                        degree += static_cast<std::uint64_t>(matrix[i][j]);
+                        for (size_t k = j + 1; k < matrix.size(); ++k) {
+                            triangles += static_cast<std::uint64_t>(
+                                matrix[i][j] != 0 && matrix[i][k] != 0 &&
+                                matrix[j][k] != 0);
+                        }
+                    }
+                    total += triangles;
+
+                    REQUIRE(counts.perVertex[i] == triangles);
+                    double expected = 0;
+                    if (degree >= 2) {
+                        expected = static_cast<double>(triangles) * 2 /
+                                   static_cast<double>(degree * (degree - 1));
+                    }
+                    REQUIRE(counts.clustering[i] == Catch::Approx(expected));
+                }
+                REQUIRE(counts.total * 3 == total);
+            }
+        }
+    }
+
+    SECTION("Same as counting cliques") {
+        Graph graph{randomMatrix(80, 0.3, 5)};
+        auto triangles = graph.countTriangles();
+        auto cliques = graph.countCliques(3);
+        REQUIRE(triangles.total == cliques[3].total);
+        REQUIRE(triangles.perVertex == cliques[3].perVertex);
+    }
+
+    SECTION("Threads don't change anything") {
+        auto adjacency = toBits(randomMatrix(300, 0.2, 7));
+        auto counts = clique::countTriangles(adjacency);
+        for (size_t threadCount : {0, 2, 4}) {
+            auto threaded = clique::countTriangles(adjacency, threadCount);
+            REQUIRE(threaded.total == counts.total);
+            REQUIRE(threaded.perVertex == counts.perVertex);
+            REQUIRE(threaded.clustering == counts.clustering);
+        }
+    }
+
+    SECTION("Small cases") {
+        auto empty = clique::countTriangles(bits::BitMatrix{0});
+        REQUIRE(empty.total == 0);
+        REQUIRE(empty.perVertex.empty());
+
+        auto complete = clique::countTriangles(toBits(randomMatrix(6, 1, 1)));
+        REQUIRE(complete.total == 20);
+        REQUIRE(complete.clustering == std::vector<double>(6, 1));
+
+        // A star's leaves have one neighbour, its centre no adjacent pair
+        bits::BitMatrix star{5};
+        for (size_t leaf = 1; leaf < 5; ++leaf) {
+            star.set(0, leaf);
+            star.set(leaf, 0);
+        }
+        auto counts = clique::countTriangles(star);
+        REQUIRE(counts.total == 0);
+        REQUIRE(counts.clustering == std::vector<double>(5, 0));
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)
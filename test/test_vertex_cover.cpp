@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "catch_amalgamated.hpp"
+#include "graph.hpp"
+#include "test_graphs.hpp"
+#include "vertex_cover.hpp"
+
+// NOLINT is only acceptable here because of the external testing macros.
+// Don't do this anywhere else.
+// NOLINTBEGIN(cppcoreguidelines-avoid-do-while)
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+
+namespace {
+
+auto isCover(const bits::BitMatrix& adjacency,
+             const std::vector<size_t>& cover) -> bool {
+    size_t vertexCount = adjacency.getSize();
+    std::vector<bool> covered(vertexCount);
+    for (size_t vertex : cover) {
+        covered[vertex] = true;
+    }
+    for (size_t i = 0; i < vertexCount; ++i) {
+        for (size_t j = 0; j < vertexCount; ++j) {
+            if (bits::test(adjacency[i], j) && !covered[i] && !covered[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Smallest cover over every subset
+auto bruteForceCoverSize(const bits::BitMatrix& adjacency) -> size_t {
+    size_t vertexCount = adjacency.getSize();
+    size_t best = vertexCount;
+    for (size_t subset = 0; subset < (size_t{1} << vertexCount); ++subset) {
+        std::vector<size_t> cover;
+        for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+            if ((subset >> vertex & 1U) != 0) {
+                cover.push_back(vertex);
+            }
+        }
+        if (cover.size() < best && isCover(adjacency, cover)) {
+            best = cover.size();
+        }
+    }
+    return best;
+}
+
+}  // namespace
+
+TEST_CASE("Minimum vertex cover") {
+    SECTION("Matches brute force") {
+        for (unsigned seed = 0; seed < 20; ++seed) {
+            for (double density : {0.1, 0.25, 0.5, 0.8}) {
+                auto adjacency = toBits(randomMatrix(11, density, seed));
+                auto cover = clique::minimumVertexCover(adjacency);
+                REQUIRE(std::ranges::is_sorted(cover));
+                REQUIRE(isCover(adjacency, cover));
+                REQUIRE(cover.size() == bruteForceCoverSize(adjacency));
+            }
+        }
+    }
+
+    SECTION("Crowns, paths and cycles") {
+        // A star is all crown: the centre covers it
+        bits::BitMatrix star{20};
+        for (size_t leaf = 1; leaf < 20; ++leaf) {
+            bits::set(star[0], leaf);
+            bits::set(star[leaf], 0);
+        }
+        REQUIRE(clique::minimumVertexCover(star) == std::vector<size_t>{0});
+
+        for (size_t vertexCount : {7, 8}) {
+            bits::BitMatrix path{vertexCount};
+            bits::BitMatrix cycle{vertexCount};
+            for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                size_t next = (vertex + 1) % vertexCount;
+                if (next != 0) {
+                    bits::set(path[vertex], next);
+                    bits::set(path[next], vertex);
+                }
+                bits::set(cycle[vertex], next);
+                bits::set(cycle[next], vertex);
+            }
+            REQUIRE(clique::minimumVertexCover(path).size() ==
+                    vertexCount / 2);
+            REQUIRE(clique::minimumVertexCover(cycle).size() ==
+                    (vertexCount + 1) / 2);
+        }
+
+        REQUIRE(clique::minimumVertexCover(bits::BitMatrix{0}).empty());
+        REQUIRE(clique::minimumVertexCover(bits::BitMatrix{5}).empty());
+    }
+}
+
+TEST_CASE("Vertex covers of graphs") {
+    SECTION("Edges count either way, loops don't") {
+        // 0 -> 1 only, 2 <-> 3, 4 has a loop
+        Graph graph{std::istringstream{"5\n"
+                                       "0 1 0 0 0\n"
+                                       "0 0 0 0 0\n"
+                                       "0 0 0 1 0\n"
+                                       "0 0 1 0 0\n"
+                                       "0 0 0 0 1"}};
+        auto cover = graph.minimumVertexCover();
+        REQUIRE(cover.size() == 2);
+        REQUIRE(std::ranges::find(cover, 4) == cover.end());
+    }
+
+    SECTION("What a minimum cover leaves out is a maximum independent set") {
+        for (unsigned seed = 0; seed < 5; ++seed) {
+            auto matrix = randomMatrix(40, 0.05, seed);
+            auto adjacency = toBits(matrix);
+            Graph graph{std::move(matrix)};
+
+            auto cover = graph.minimumVertexCover();
+            REQUIRE(std::ranges::is_sorted(cover));
+            REQUIRE(isCover(adjacency, cover));
+            REQUIRE(cover.size() + graph.maximumIndependentSet().size() ==
+                    40);
+        }
+    }
+}
+
+TEST_CASE("Dense graphs go through the complement") {
+    // Sparse complements, so maxClique takes the complement route while
+    // allMaxCliques still runs the clique search
+    for (size_t vertexCount : {30, 40, 50}) {
+        DYNAMIC_SECTION(vertexCount << " vertices") {
+            auto complement = toBits(randomMatrix(vertexCount, 0.06, 17));
+            std::vector<std::vector<int>> matrix(vertexCount,
+                                                 std::vector<int>(vertexCount));
+            for (size_t i = 0; i < vertexCount; ++i) {
+                for (size_t j = 0; j < vertexCount; ++j) {
+                    matrix[i][j] = static_cast<int>(
+                        i != j && !bits::test(complement[i], j));
+                }
+            }
+            Graph graph{std::move(matrix)};
+
+            auto clique = graph.maxClique();
+            auto all = graph.allMaxCliques();
+            REQUIRE(std::ranges::find(all, clique) != all.end());
+            REQUIRE(graph.maxClique(AlgorithmAccuracy::EXACT, 4).size() ==
+                    clique.size());
+        }
+    }
+}
+
+// NOLINTEND(readability-function-cognitive-complexity)
+// NOLINTEND(cppcoreguidelines-avoid-do-while)